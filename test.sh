@@ -27,6 +27,9 @@ bats ./test/functional/start.bats.sh
 printf "\n\033[4mTest stop command\033[0m\n"
 bats ./test/functional/stop.bats.sh
 
+printf "\n\033[4mTest status command\033[0m\n"
+bats ./test/functional/status.bats.sh
+
 printf "\n\033[4mTest resume command\033[0m\n"
 bats ./test/functional/resume.bats.sh
 
@@ -51,11 +54,20 @@ bats ./test/functional/day.bats.sh
 printf "\n\033[4mTest remove command\033[0m\n"
 bats ./test/functional/remove.bats.sh
 
-printf "\n\033[4mTest undo command and backup creation\033[0m\n"
+printf "\n\033[4mTest undo and redo commands and backup creation\033[0m\n"
 bats ./test/functional/undo-backup.bats.sh
 
 printf "\n\033[4mTest view command\033[0m\n"
 bats ./test/functional/view.bats.sh
 
+printf "\n\033[4mTest stats command\033[0m\n"
+bats ./test/functional/stats.bats.sh
+
+printf "\n\033[4mTest export command\033[0m\n"
+bats ./test/functional/export.bats.sh
+
+printf "\n\033[4mTest C API of libttt\033[0m\n"
+bats ./test/functional/libttt.bats.sh
+
 ELAPSED_TIME=$(($SECONDS - $START_TIME))
 printf "\nDone. Bats tests ran for $ELAPSED_TIME seconds.\n\n";
@@ -0,0 +1,62 @@
+#!/usr/bin/env bats
+
+########################################################################################################################
+# Test export command
+########################################################################################################################
+
+load test_helper
+
+@test '"export --format=columnar" creates columnar file' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt p
+
+  run $BATS_TEST_DIRNAME/ttt export --format=columnar $BATS_TEST_DIRNAME/timesheet.ttc
+  [ "$status" -eq 0 ]
+  [[ "$output" = *"Exported timesheet columns to: "* ]]
+  [ -f $BATS_TEST_DIRNAME/timesheet.ttc ]
+
+  rm $BATS_TEST_DIRNAME/timesheet.ttc
+}
+
+@test '"export" w/ unknown format fails' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+
+  run $BATS_TEST_DIRNAME/ttt export --format=foo
+  [[ "$output" = *"Unknown format"* ]]
+}
+
+@test '"stats" of columnar export equals stats of timesheet' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt s bar 456
+  $BATS_TEST_DIRNAME/ttt s baz 123
+  $BATS_TEST_DIRNAME/ttt p
+  $BATS_TEST_DIRNAME/ttt export --format=columnar $BATS_TEST_DIRNAME/timesheet.ttc
+
+  for group in task day week month year; do
+    expected=$($BATS_TEST_DIRNAME/ttt stats $group)
+    run $BATS_TEST_DIRNAME/ttt stats $group f=$BATS_TEST_DIRNAME/timesheet.ttc
+    [ "$output" = "$expected" ]
+  done
+
+  run $BATS_TEST_DIRNAME/ttt stats month t=123 f=$BATS_TEST_DIRNAME/timesheet.ttc
+  [[ "$output" = *" Total   |       2 |"* ]]
+
+  rm $BATS_TEST_DIRNAME/timesheet.ttc
+}
+
+@test '"export --format=ndjson" writes one JSON object per line' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt s bar 456
+  $BATS_TEST_DIRNAME/ttt p
+
+  run $BATS_TEST_DIRNAME/ttt export --format=ndjson $BATS_TEST_DIRNAME/timesheet.ndjson
+  [ "$status" -eq 0 ]
+
+  amount_entries=$(grep -c '^{"type":"entry",.*}$' $BATS_TEST_DIRNAME/timesheet.ndjson | xargs)
+  amount_days=$(grep -c '^{"type":"day",.*}$' $BATS_TEST_DIRNAME/timesheet.ndjson | xargs)
+
+  rm $BATS_TEST_DIRNAME/timesheet.ndjson
+
+  [ "$amount_entries" -eq 2 ]
+  [ "$amount_days" -eq 1 ]
+}
@@ -87,6 +87,11 @@ load test_helper
   $BATS_TEST_DIRNAME/ttt h z | grep 'undo (z):'
 }
 
+@test "\"help redo\" (and variations) display help on redo command" {
+  $BATS_TEST_DIRNAME/ttt help redo | grep 'redo:'
+  $BATS_TEST_DIRNAME/ttt h redo | grep 'redo:'
+}
+
 @test "\"help recalculate\" (and variations) display help on recalculate command" {
   $BATS_TEST_DIRNAME/ttt help recalculate | grep 'recalculate (rc):'
   $BATS_TEST_DIRNAME/ttt help rc | grep 'recalculate (rc):'
@@ -0,0 +1,20 @@
+#!/usr/bin/env bats
+
+########################################################################################################################
+# Test C API of libttt (ttt/lib/libttt.h)
+########################################################################################################################
+
+load test_helper
+
+@test 'C API starts, stops, sets task, undoes, reads entries and runs commands' {
+  directory=$BATS_TMPDIR/ttt-libttt
+  rm -rf $directory
+  mkdir $directory
+
+  run $BATS_TEST_DIRNAME/../../bin/$OS/libttt_test $directory
+
+  rm -rf $directory
+
+  echo "$output"
+  [ "$status" -eq 0 ]
+}
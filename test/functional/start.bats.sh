@@ -152,3 +152,15 @@ load test_helper
   run grep -c '>34:56<' "$BATS_TEST_DIRNAME"/timesheet.html
   [[ "$output" = 1 ]]
 }
+
+@test 'Concurrently started entries are all kept' {
+  run "$BATS_TEST_DIRNAME"/ttt s
+
+  for i in 1 2 3 4 5 6 7 8; do
+    "$BATS_TEST_DIRNAME"/ttt s "$i" &
+  done
+  wait
+
+  run grep -c '<td class="meta">' "$BATS_TEST_DIRNAME"/timesheet.html
+  [[ "$output" = 9 ]]
+}
@@ -0,0 +1,88 @@
+#!/usr/bin/env bats
+
+########################################################################################################################
+# Test stats command
+########################################################################################################################
+
+load test_helper
+
+@test '"stats" displays amount of entries per task, and in total' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt s bar 456
+  $BATS_TEST_DIRNAME/ttt s baz 123
+  $BATS_TEST_DIRNAME/ttt p
+
+  run $BATS_TEST_DIRNAME/ttt stats
+  [ "$status" -eq 0 ]
+  [[ "$output" = *" 123   |       2 |"* ]]
+  [[ "$output" = *" 456   |       1 |"* ]]
+  [[ "$output" = *" Total |       3 |"* ]]
+}
+
+@test '"stats" w/ task filter and grouped by month, displays only entries of the task' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt s bar 456
+  $BATS_TEST_DIRNAME/ttt s baz 123
+  $BATS_TEST_DIRNAME/ttt p
+
+  month=$(date +%Y/%m)
+
+  run $BATS_TEST_DIRNAME/ttt stats month t=123
+  [[ "$output" = *" $month |       2 |"* ]]
+  [[ "$output" = *" Total   |       2 |"* ]]
+}
+
+@test '"stats" w/ period filter displays only entries within the period' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt p
+
+  run $BATS_TEST_DIRNAME/ttt stats year p=$(date +%Y)
+  [[ "$output" = *" Total |       1 |"* ]]
+
+  run $BATS_TEST_DIRNAME/ttt stats year p=2000-2001
+  [[ "$output" = *"No entries found"* ]]
+
+  run $BATS_TEST_DIRNAME/ttt stats p=2000/13
+  [[ "$output" = *"Invalid period"* ]]
+}
+
+@test '"stats" keeps rollups, which are updated by modifications' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt p
+
+  run $BATS_TEST_DIRNAME/ttt stats month
+  [ -f $BATS_TEST_DIRNAME/timesheet.html.rollups ]
+
+  $BATS_TEST_DIRNAME/ttt s bar 456
+  $BATS_TEST_DIRNAME/ttt p
+  $BATS_TEST_DIRNAME/ttt s baz 123
+  $BATS_TEST_DIRNAME/ttt p
+
+  [ -f $BATS_TEST_DIRNAME/timesheet.html.rollups ]
+
+  month=$(date +%Y/%m)
+
+  run $BATS_TEST_DIRNAME/ttt stats month
+  [[ "$output" = *" $month |       3 |"* ]]
+  rollups="$output"
+
+  # Aggregated from the rows of the timesheet, as rollups cover whole months only
+  run $BATS_TEST_DIRNAME/ttt stats month p=${month}/01-${month}/31
+  [ "$output" = "$rollups" ]
+
+  run $BATS_TEST_DIRNAME/ttt stats task
+  [[ "$output" = *" 123   |       2 |"* ]]
+}
+
+@test '"stats" rebuilds rollups, that are outdated' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt p
+  $BATS_TEST_DIRNAME/ttt stats month
+
+  $BATS_TEST_DIRNAME/ttt undo
+  [ ! -f $BATS_TEST_DIRNAME/timesheet.html.rollups ]
+
+  run $BATS_TEST_DIRNAME/ttt stats week
+  [[ "$output" = *" Total    |       1 |"* ]]
+  [ -f $BATS_TEST_DIRNAME/timesheet.html.rollups ]
+}
@@ -0,0 +1,51 @@
+#!/usr/bin/env bats
+
+########################################################################################################################
+# Test status command
+########################################################################################################################
+
+load test_helper
+
+@test 'If no entry runs, "status" displays there is no ongoing entry' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt p
+
+  run $BATS_TEST_DIRNAME/ttt st
+  [ "$status" -eq 0 ]
+  [[ "$output" = "No ongoing entry, today "* ]]
+}
+
+@test 'If an entry runs, "status" displays its task, comment and start-time via given template' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  $BATS_TEST_DIRNAME/ttt s "bar baz" 456
+
+  start=$(grep -o '<td>[0-9][0-9]:[0-9][0-9]</td><td>\.\.\.</td>' $BATS_TEST_DIRNAME/timesheet.html | cut -c 5-9)
+
+  run $BATS_TEST_DIRNAME/ttt status "%t|%c|%s|%%"
+  [ "$status" -eq 0 ]
+  [[ "$output" = "456|bar baz|$start|%" ]]
+}
+
+@test '"status" reflects modifications, also undo' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+
+  run $BATS_TEST_DIRNAME/ttt st "%t"
+  [[ "$output" = "123" ]]
+
+  $BATS_TEST_DIRNAME/ttt t 456
+  run $BATS_TEST_DIRNAME/ttt st "%t"
+  [[ "$output" = "456" ]]
+
+  $BATS_TEST_DIRNAME/ttt z
+  run $BATS_TEST_DIRNAME/ttt st "%t"
+  [[ "$output" = "123" ]]
+}
+
+@test 'If the status file is missing, "status" rebuilds it from the timesheet' {
+  $BATS_TEST_DIRNAME/ttt s foo 123
+  rm $BATS_TEST_DIRNAME/timesheet.html.status
+
+  run $BATS_TEST_DIRNAME/ttt st "%t %c"
+  [[ "$output" = "123 foo" ]]
+  [ -f $BATS_TEST_DIRNAME/timesheet.html.status ]
+}
@@ -20,5 +20,8 @@ teardown() {
   if [ -f $BATS_TEST_DIRNAME/ttt ] ; then rm $BATS_TEST_DIRNAME/ttt; fi
   if [ -f $BATS_TEST_DIRNAME/.ttt.ini ] ; then rm $BATS_TEST_DIRNAME/.ttt.ini; fi
   if [ -f $BATS_TEST_DIRNAME/timesheet.html ] ; then rm $BATS_TEST_DIRNAME/timesheet.html; fi
-  if [ -f $BATS_TEST_DIRNAME/timesheet.html.bak ] ; then rm $BATS_TEST_DIRNAME/timesheet.html.bak; fi
+  rm -f $BATS_TEST_DIRNAME/timesheet.html.undo*
+  rm -f $BATS_TEST_DIRNAME/timesheet.html.lock
+  rm -f $BATS_TEST_DIRNAME/timesheet.html.status
+  rm -f $BATS_TEST_DIRNAME/timesheet.html.rollups
 }
@@ -1,7 +1,7 @@
 #!/usr/bin/env bats
 
 ########################################################################################################################
-# Test undo command and backup creation
+# Test undo and redo commands and backup creation
 ########################################################################################################################
 
 load test_helper
@@ -10,7 +10,7 @@ load test_helper
   $BATS_TEST_DIRNAME/ttt z | grep 'Cannot undo'
 
   $BATS_TEST_DIRNAME/ttt s
-  # Undoing also removes backup, so one cannot twice successively
+  # Only one modification was recorded, so one cannot undo twice successively
   $BATS_TEST_DIRNAME/ttt z
   $BATS_TEST_DIRNAME/ttt z | grep 'Cannot undo'
 }
@@ -19,8 +19,8 @@ load test_helper
   # timesheet.html does not exist
   run ls $BATS_TEST_DIRNAME/timesheet.html
   [ "$status" -ne 0 ]
-  # timesheet.html.bak does not exist
-  run ls $BATS_TEST_DIRNAME/timesheet.html.bak
+  # Undo history does not exist
+  run ls $BATS_TEST_DIRNAME/timesheet.html.undo
   [ "$status" -ne 0 ]
 
   # Add entry, create timesheet.html and backup
@@ -29,12 +29,14 @@ load test_helper
   # timesheet.html does exist
   run ls $BATS_TEST_DIRNAME/timesheet.html
   [ "$status" -eq 0 ]
-  # timesheet.html.bak does exist
-  run ls $BATS_TEST_DIRNAME/timesheet.html.bak
+  # Undo history and record of the modification do exist
+  run ls $BATS_TEST_DIRNAME/timesheet.html.undo
+  [ "$status" -eq 0 ]
+  run ls $BATS_TEST_DIRNAME/timesheet.html.undo.0
   [ "$status" -eq 0 ]
 }
 
-@test 'After starting a new entry, there is 1 more entry in timesheet than in the backup' {
+@test 'After starting a new entry, undo removes it again' {
   # Add entry, create timesheet.html
   run $BATS_TEST_DIRNAME/ttt s
   # There is 1 ongoing entry now
@@ -47,12 +49,17 @@ load test_helper
   # There are two entries in timesheet.html
   run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 2 ]]
-  # There is one entry in timesheet.html.bak
-  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html.bak
+
+  run $BATS_TEST_DIRNAME/ttt z
+
+  # There is one entry in timesheet.html, ongoing again
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 1 ]]
+  run grep -c '<td class="meta">s/' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 1 ]]
 }
 
-@test "After updating start-time of an entry, the previous time is still in the backup" {
+@test "After updating start-time of an entry, undo restores the previous time" {
   run $BATS_TEST_DIRNAME/ttt s
   run $BATS_TEST_DIRNAME/ttt p
   run $BATS_TEST_DIRNAME/ttt s i=0 01:23
@@ -61,11 +68,16 @@ load test_helper
   [[ "$output" = 0 ]]
   run grep -c '02:34' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 1 ]]
-  run grep -c '01:23' $BATS_TEST_DIRNAME/timesheet.html.bak
+
+  run $BATS_TEST_DIRNAME/ttt z
+
+  run grep -c '01:23' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 1 ]]
+  run grep -c '02:34' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 0 ]]
 }
 
-@test "After updating end-time of an entry, the previous time is still in the backup" {
+@test "After updating end-time of an entry, undo restores the previous time" {
   run $BATS_TEST_DIRNAME/ttt s
   run $BATS_TEST_DIRNAME/ttt p
   run $BATS_TEST_DIRNAME/ttt p i=0 01:23
@@ -74,11 +86,14 @@ load test_helper
   [[ "$output" = 0 ]]
   run grep -c '02:34' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 1 ]]
-  run grep -c '01:23' $BATS_TEST_DIRNAME/timesheet.html.bak
+
+  run $BATS_TEST_DIRNAME/ttt z
+
+  run grep -c '01:23' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 1 ]]
 }
 
-@test 'After removing 1 entry, there is 1 entry more in backup than in timesheet' {
+@test 'After removing 1 entry, undo restores it' {
   # Create 4 entries
   $BATS_TEST_DIRNAME/ttt s
   $BATS_TEST_DIRNAME/ttt s
@@ -90,12 +105,15 @@ load test_helper
   # There are 3 entries in timesheet.html
   amount_entries=$(cat $BATS_TEST_DIRNAME/timesheet.html | grep "<td class=\"meta\">" -o | wc -l | xargs)
   [[ "$amount_entries" = 3 ]]
-  # There are 4 entries in timesheet.html.bak
-  amount_entries=$(cat $BATS_TEST_DIRNAME/timesheet.html.bak | grep "<td class=\"meta\">" -o | wc -l | xargs)
+
+  $BATS_TEST_DIRNAME/ttt z
+
+  # There are 4 entries in timesheet.html
+  amount_entries=$(cat $BATS_TEST_DIRNAME/timesheet.html | grep "<td class=\"meta\">" -o | wc -l | xargs)
   [[ "$amount_entries" = 4 ]]
 }
 
-@test 'After merging 2 entries, there is 1 entry less in backup than in timesheet' {
+@test 'After merging 2 entries, undo splits them again' {
   run $BATS_TEST_DIRNAME/ttt s "fixed bug"
   run $BATS_TEST_DIRNAME/ttt s "tested"
   run $BATS_TEST_DIRNAME/ttt p
@@ -106,12 +124,15 @@ load test_helper
   # There is 1 entry in timesheet.html
   amount_entries=$(cat $BATS_TEST_DIRNAME/timesheet.html | grep "<td class=\"meta\">" -o | wc -l | xargs)
   [[ "$amount_entries" = 1 ]]
-  # There are 2 entries in timesheet.html.bak
-  amount_entries=$(cat $BATS_TEST_DIRNAME/timesheet.html.bak | grep "<td class=\"meta\">" -o | wc -l | xargs)
+
+  run $BATS_TEST_DIRNAME/ttt z
+
+  # There are 2 entries in timesheet.html
+  amount_entries=$(cat $BATS_TEST_DIRNAME/timesheet.html | grep "<td class=\"meta\">" -o | wc -l | xargs)
   [[ "$amount_entries" = 2 ]]
 }
 
-@test 'After splitting 1 entry, there is 1 entry less in backup than in timesheet' {
+@test 'After splitting 1 entry, undo merges them again' {
   $BATS_TEST_DIRNAME/ttt s
   $BATS_TEST_DIRNAME/ttt p
   $BATS_TEST_DIRNAME/ttt s i=0 01:23
@@ -120,7 +141,10 @@ load test_helper
 
   run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 2 ]]
-  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html.bak
+
+  $BATS_TEST_DIRNAME/ttt z
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" = 1 ]]
 }
 
@@ -146,3 +170,98 @@ load test_helper
   run grep -c '01:23' $BATS_TEST_DIRNAME/timesheet.html
   [[ "$output" -eq 1 ]]
 }
+
+@test 'Undo w/ given amount reverts multiple operations' {
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt s
+
+  $BATS_TEST_DIRNAME/ttt z 2
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 1 ]]
+
+  $BATS_TEST_DIRNAME/ttt undo 5
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 0 ]]
+}
+
+@test 'Redo re-applies undone operations' {
+  $BATS_TEST_DIRNAME/ttt redo | grep 'Cannot redo'
+
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt z 2
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 0 ]]
+
+  $BATS_TEST_DIRNAME/ttt redo
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 1 ]]
+
+  $BATS_TEST_DIRNAME/ttt redo
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 2 ]]
+
+  $BATS_TEST_DIRNAME/ttt redo | grep 'Cannot redo'
+}
+
+@test 'Modifying the timesheet after undo discards redoable operations' {
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt z
+  $BATS_TEST_DIRNAME/ttt c "foo"
+
+  $BATS_TEST_DIRNAME/ttt redo | grep 'Cannot redo'
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 1 ]]
+}
+
+@test 'Amount of undoable operations is limited to configured undo_depth' {
+  # Initialize config
+  $BATS_TEST_DIRNAME/ttt V
+  sed -i.tmp 's/^undo_depth=.*/undo_depth=2/' $BATS_TEST_DIRNAME/.ttt.ini
+  rm $BATS_TEST_DIRNAME/.ttt.ini.tmp
+
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt s
+
+  $BATS_TEST_DIRNAME/ttt z 5
+
+  run grep -c '<td class="meta">' $BATS_TEST_DIRNAME/timesheet.html
+  [[ "$output" = 1 ]]
+
+  $BATS_TEST_DIRNAME/ttt z | grep 'Cannot undo'
+}
+
+@test 'Large changes of a symlinked timesheet replace its target, w/ its mode' {
+  $BATS_TEST_DIRNAME/ttt s
+  $BATS_TEST_DIRNAME/ttt c "$(head -c 70000 /dev/zero | tr '\0' 'x')"
+
+  mv $BATS_TEST_DIRNAME/timesheet.html $BATS_TEST_DIRNAME/timesheet.target.html
+  chmod 600 $BATS_TEST_DIRNAME/timesheet.target.html
+  ln -s timesheet.target.html $BATS_TEST_DIRNAME/timesheet.html
+
+  # Replacing the whole timesheet keeps a snapshot of it for undo
+  $BATS_TEST_DIRNAME/ttt cls y
+
+  [[ -L $BATS_TEST_DIRNAME/timesheet.html ]]
+  run grep -c 'xxxxxxxx' $BATS_TEST_DIRNAME/timesheet.target.html
+  [[ "$output" = 0 ]]
+
+  $BATS_TEST_DIRNAME/ttt z
+
+  [[ -L $BATS_TEST_DIRNAME/timesheet.html ]]
+  run grep -c 'xxxxxxxx' $BATS_TEST_DIRNAME/timesheet.target.html
+  [[ "$output" = 1 ]]
+  run ls -l $BATS_TEST_DIRNAME/timesheet.target.html
+  [[ "$output" = -rw-------* ]]
+
+  rm $BATS_TEST_DIRNAME/timesheet.html $BATS_TEST_DIRNAME/timesheet.target.html
+}
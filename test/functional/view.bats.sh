@@ -35,3 +35,87 @@ load test_helper
   amount_separators=$("$BATS_TEST_DIRNAME"/ttt v | grep "|" -o | wc -l | xargs)
   [[ "$amount_separators" -eq 66 ]]
 }
+
+@test 'Viewing the tail displays only the latest entries, w/ their IDs' {
+  for i in 1 2 3 4 5; do
+    "$BATS_TEST_DIRNAME"/ttt s "entry$i"
+  done
+  "$BATS_TEST_DIRNAME"/ttt p
+
+  amount_separators=$("$BATS_TEST_DIRNAME"/ttt v --tail 2 | grep "|" -o | wc -l | xargs)
+  [[ "$amount_separators" -eq 33 ]]
+
+  run "$BATS_TEST_DIRNAME"/ttt v --tail 2
+  [[ "$output" != *"entry3"* ]]
+  [[ "$output" = *"entry4"* ]]
+  [[ "$output" = *"entry5"* ]]
+  [[ "$output" = *"|  3 "* ]]
+  [[ "$output" = *"|  4 "* ]]
+}
+
+@test 'Viewing the tail of days displays all entries of the latest day' {
+  for i in 1 2 3; do
+    "$BATS_TEST_DIRNAME"/ttt s "entry$i"
+  done
+
+  amount_separators=$("$BATS_TEST_DIRNAME"/ttt v --tail 1d | grep "|" -o | wc -l | xargs)
+  [[ "$amount_separators" -eq 44 ]]
+}
+
+@test 'Viewing the timesheet w/ output piped, contains no ANSI codes' {
+  "$BATS_TEST_DIRNAME"/ttt s "foo bar baz" 123
+  "$BATS_TEST_DIRNAME"/ttt p
+
+  amount=$("$BATS_TEST_DIRNAME"/ttt v | grep -c $'\033' | xargs)
+  [[ "$amount" = 0 ]]
+}
+
+@test 'Viewing w/ pager and output piped, prints the timesheet' {
+  "$BATS_TEST_DIRNAME"/ttt s "foo bar baz" 123
+  "$BATS_TEST_DIRNAME"/ttt p
+
+  run "$BATS_TEST_DIRNAME"/ttt v --pager
+  [ "$status" -eq 0 ]
+  [[ "$output" = *"foo bar baz"* ]]
+}
+
+@test 'Watching the timesheet w/ output piped, prints it again upon modification' {
+  "$BATS_TEST_DIRNAME"/ttt s "foo bar baz" 123
+
+  (sleep 1; "$BATS_TEST_DIRNAME"/ttt s "qux" 456) &
+
+  run timeout 3 "$BATS_TEST_DIRNAME"/ttt v --watch
+  wait
+
+  [[ "$output" = *"foo bar baz"* ]]
+  [[ "$output" = *"qux"* ]]
+
+  amount_views=$(echo "$output" | grep -c "Watching timesheet.html" | xargs)
+  [[ "$amount_views" -ge 2 ]]
+}
+
+@test 'Viewing w/ --json outputs entries, day sum and balance as JSON' {
+  "$BATS_TEST_DIRNAME"/ttt s "foo \"bar\" baz" 123
+  "$BATS_TEST_DIRNAME"/ttt s qux 456
+  "$BATS_TEST_DIRNAME"/ttt p
+
+  run "$BATS_TEST_DIRNAME"/ttt v d --json
+  [ "$status" -eq 0 ]
+  [[ "${lines[0]}" = "[" ]]
+  [[ "$output" = *'{"type":"entry","id":0,'* ]]
+  [[ "$output" = *'"task":"123","comment":"foo \"bar\" baz"'* ]]
+  [[ "$output" = *'{"type":"day","date":"'* ]]
+  [[ "${lines[-1]}" = "]" ]]
+}
+
+@test 'Viewing w/ --json and task filter outputs only entries of the task' {
+  "$BATS_TEST_DIRNAME"/ttt s foo 123
+  "$BATS_TEST_DIRNAME"/ttt s bar 456
+  "$BATS_TEST_DIRNAME"/ttt p
+
+  run "$BATS_TEST_DIRNAME"/ttt v --tail 5 --json t=456
+  [ "$status" -eq 0 ]
+  [[ "$output" = *'"task":"456"'* ]]
+  [[ "$output" != *'"task":"123"'* ]]
+  [[ "$output" != *'"type":"day"'* ]]
+}
@@ -0,0 +1,112 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Functional test of the C API of libttt: run w/ an empty directory, in
+// which the timesheet is created. Prints failed checks, exits w/ 1 if any
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ttt/lib/libttt.h>
+
+static int amount_failed = 0;
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      printf("Failed (line %d): %s\n", __LINE__, #condition); \
+      ++amount_failed; \
+    } \
+  } while (0)
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    printf("Usage: %s <directory>\n", argv[0]);
+
+    return 1;
+  }
+
+  CHECK(TTT_API_VERSION == ttt_get_api_version());
+
+  ttt_timesheet *timesheet = ttt_open(argv[1]);
+
+  if (NULL == timesheet) {
+    printf("Failed opening timesheet in: %s\n", argv[1]);
+
+    return 1;
+  }
+
+  CHECK(0 == ttt_get_amount_entries(timesheet));
+
+  ttt_entry entry;
+
+  CHECK(TTT_ERROR == ttt_get_entry(timesheet, TTT_ID_LATEST, &entry));
+
+  // Start: adds an ongoing entry
+  CHECK(TTT_OK == ttt_start(timesheet, 123, "review"));
+  CHECK(1 == ttt_get_amount_entries(timesheet));
+  CHECK(TTT_OK == ttt_get_entry(timesheet, TTT_ID_LATEST, &entry));
+  CHECK(0 == entry.id);
+  CHECK(entry.date > 20000000);
+  CHECK(1 == entry.is_ongoing);
+  CHECK(0 == strcmp("123", entry.task));
+  CHECK(0 == strcmp("review", entry.comment));
+  CHECK(5 == strlen(entry.start));
+
+  // Stop: ends it
+  CHECK(TTT_OK == ttt_stop(timesheet, NULL));
+  CHECK(TTT_OK == ttt_get_entry(timesheet, 0, &entry));
+  CHECK(0 == entry.is_ongoing);
+  CHECK(5 == strlen(entry.end));
+  CHECK(0 == strcmp("00:00", entry.duration));
+
+  // Set task
+  CHECK(TTT_OK == ttt_set_task(timesheet, TTT_ID_LATEST, 456));
+  CHECK(TTT_OK == ttt_get_entry(timesheet, 0, &entry));
+  CHECK(0 == strcmp("456", entry.task));
+
+  // Undo reverts the latest modification only
+  CHECK(TTT_OK == ttt_start(timesheet, TTT_NO_TASK, "second"));
+  CHECK(2 == ttt_get_amount_entries(timesheet));
+  CHECK(TTT_OK == ttt_undo(timesheet));
+  CHECK(1 == ttt_get_amount_entries(timesheet));
+  CHECK(TTT_OK == ttt_get_entry(timesheet, TTT_ID_LATEST, &entry));
+  CHECK(0 == strcmp("456", entry.task));
+  CHECK(TTT_ERROR == ttt_get_entry(timesheet, 1, &entry));
+
+  // Other commands, w/ captured output
+  const char *arguments[] = {"v", "--json"};
+
+  CHECK(TTT_OK == ttt_execute(timesheet, 2, arguments));
+  CHECK(NULL != strstr(ttt_get_output(timesheet), "\"task\":\"456\""));
+  CHECK(NULL != strstr(ttt_get_output(timesheet), "\"comment\":\"review\""));
+
+  ttt_close(timesheet);
+
+  if (0 == amount_failed) printf("All checks passed.\n");
+
+  return 0 == amount_failed ? 0 : 1;
+}
@@ -31,8 +31,16 @@
 #include <ttt/class/app/app_help.h>
 #include <ttt/class/report/report_backup.h>
 #include <ttt/class/report/report_browser.h>
+#include <ttt/class/report/report_columnar.h>
 #include <ttt/class/report/report_file.h>
+#include <ttt/class/report/report_lock.h>
+#include <ttt/class/report/report_pager.h>
+#include <ttt/class/report/report_rollups.h>
+#include <ttt/class/report/report_stats.h>
+#include <ttt/class/report/report_status.h>
+#include <ttt/class/report/report_watcher.h>
 #include <ttt/class/report/report_renderer_csv.h>
+#include <ttt/class/report/report_renderer_json.h>
 #include <ttt/class/report/report_renderer_cli.h>
 #include <ttt/class/report/report_recalculator.h>
 
@@ -55,24 +63,23 @@ App::App(int argc, char **argv) {
 bool App::Process() {
   AppCommand::Commands kCommand = command_->GetResolved();
 
-  bool keep_backup;
-  ReportBackup::BackupReportBeforeProcessCommand(kCommand);
+  bool result;
+
+  // Ask before locking, not to block other ttt processes meanwhile
+  if (AppCommand::Command_ClearTimesheet == kCommand
+      && !IsClearTimesheetConfirmed()) {
+    return true;
+  }
+
+  if (!ReportLock::Acquire(kCommand)) return false;
+
+  if (ReportBackup::BackupReportBeforeProcessCommand(kCommand)) {
+    ReportRollups::Prepare();
+  }
 
   switch (kCommand) {
     case AppCommand::Command_ClearTimesheet:{
-      if (arguments_->argc_ > 2 && arguments_->ResolveYesNo(2)) {
-        keep_backup = ClearTimesheet();
-      } else {
-        std::cout << "Really clear timesheet, [y]es or [N]o?";
-        bool do_clear = helper::System::GetNoOrYesKeyPress();
-        std::cout << "\n";
-
-        if (!do_clear) {
-          return true;
-        }
-
-        keep_backup = ClearTimesheet();
-      }
+      result = ClearTimesheet();
 
       break;
     }
@@ -85,7 +92,7 @@ bool App::Process() {
       return BrowseTaskUrl();
     }
     case AppCommand::Command_Comment:{
-      keep_backup = UpdateComment();
+      result = UpdateComment();
 
       break;
     }
@@ -97,13 +104,16 @@ bool App::Process() {
     case AppCommand::Command_Csv: {
       return ExportCsv();
     }
+    case AppCommand::Command_Export: {
+      return Export();
+    }
     case AppCommand::Command_DisplayDate: {
       DisplayDate();
 
       return true;
     }
     case AppCommand::Command_Day: {
-      keep_backup = AddFullDayEntry();
+      result = AddFullDayEntry();
       break;
     }
     case AppCommand::Command_Help: {
@@ -112,17 +122,17 @@ bool App::Process() {
       return true;
     }
     case AppCommand::Command_Merge: {
-      keep_backup = Merge();
+      result = Merge();
 
       break;
     }
     case AppCommand::Command_Recalculate: {
-      keep_backup = Recalculate();
+      result = Recalculate();
 
       break;
     }
     case AppCommand::Command_Resume: {
-      keep_backup = Resume();
+      result = Resume();
 
       break;
     }
@@ -133,32 +143,54 @@ bool App::Process() {
       return CsvTodayTracks();
     }
     case AppCommand::Command_Remove:{
-      keep_backup = Remove();
+      result = Remove();
 
       break;
     }
     case AppCommand::Command_Split: {
-      keep_backup = Split();
+      result = Split();
 
       break;
     }
     case AppCommand::Command_Start: {
-      keep_backup = Start();
+      result = Start();
 
       break;
     }
+    case AppCommand::Command_Stats: {
+      return Stats();
+    }
+    case AppCommand::Command_Status: {
+      return ReportStatus::Print(
+          arguments_->argc_ > 2 ? arguments_->argv_[2] : "");
+    }
     case AppCommand::Command_Stop: {
-      keep_backup = Stop();
+      result = Stop();
 
       break;
     }
     case AppCommand::Command_Task: {
-      keep_backup = UpdateTaskNumber();
+      result = UpdateTaskNumber();
 
       break;
     }
     case AppCommand::Command_Undo: {
-      return ReportBackup::RestoreBackup();
+      result = ReportBackup::Undo(
+          arguments_->IsNumber(2) ? arguments_->ResolveNumber(2) : 1);
+
+      ReportStatus::Update();
+      ReportRollups::Update();
+
+      return result;
+    }
+    case AppCommand::Command_Redo: {
+      result = ReportBackup::Redo(
+          arguments_->IsNumber(2) ? arguments_->ResolveNumber(2) : 1);
+
+      ReportStatus::Update();
+      ReportRollups::Update();
+
+      return result;
     }
     case AppCommand::Command_Version: {
       AppHelp::PrintVersion();
@@ -183,9 +215,16 @@ bool App::Process() {
     }
   }
 
-  return keep_backup
-         ? ReportBackup::ActivateTemporaryBackup()
-         : ReportBackup::RemoveTemporaryBackup();
+  // Update rollups from the recorded changes, before committing them
+  ReportRollups::Update();
+
+  // Also record changes of failed commands, to keep history and timesheet
+  // in sync
+  bool is_committed = ReportBackup::CommitChanges();
+
+  ReportStatus::Update();
+
+  return is_committed && result;
 }
 
 // TODO(kay): cmd d crashes when current day has < time left than
@@ -276,6 +315,63 @@ void App::DisplayDate() {
   delete report_date_time;
 }
 
+// Export timesheet to file of format given via --format:
+// csv, columnar, json or ndjson
+bool App::Export() {
+  const std::string &format = arguments_->format_;
+
+  if (format.empty() || "csv" == format) return ExportCsv();
+
+  if ("columnar" != format && "json" != format && "ndjson" != format) {
+    return AppError::PrintError(
+        "Unknown format. Formats: csv, columnar, json, ndjson");
+  }
+
+  // Optional path, default: named like the CSV export
+  std::string path;
+
+  for (int index = 2; index < arguments_->argc_; ++index) {
+    std::string argument = arguments_->argv_[index];
+
+    if (!helper::String::StartsWith(argument.c_str(), "--")) path = argument;
+  }
+
+  if (path.empty()) {
+    path = ReportRendererCsv::GetFilename();
+
+    if (path.empty()) return AppError::PrintError("Cannot read timesheet.");
+
+    path = path.substr(0, path.size() - std::strlen(".csv"))
+        .append("columnar" == format ? ".ttc" : "." + format);
+  }
+
+  if ("columnar" == format) {
+    if (!ReportColumnar::Export(path)) {
+      return AppError::PrintError("Failed export of timesheet columns.");
+    }
+
+    std::cout << "Exported timesheet columns to: " << path << "\n";
+
+    return true;
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+  ReportRendererJson renderer(
+      &file,
+      "json" == format
+      ? ReportRendererJson::Format_Json
+      : ReportRendererJson::Format_Ndjson);
+
+  if (!file || !renderer.Render(Report::Scope_All, 0, -1)) {
+    return AppError::PrintError("Failed export of timesheet to JSON.");
+  }
+
+  std::cout << "Exported timesheet JSON to: " << path << "\n";
+
+  return true;
+}
+
 // Export whole report to CSV file
 bool App::ExportCsv() {
   ReportRendererCsv renderer;
@@ -771,6 +867,16 @@ bool App::ClearTimesheet() {
   return true;
 }
 
+bool App::IsClearTimesheetConfirmed() const {
+  if (arguments_->argc_ > 2 && arguments_->ResolveYesNo(2)) return true;
+
+  std::cout << "Really clear timesheet, [y]es or [N]o?";
+  bool do_clear = helper::System::GetNoOrYesKeyPress();
+  std::cout << "\n";
+
+  return do_clear;
+}
+
 bool App::UpdateCommentByEntryId(
     int last_index,
     int index,
@@ -911,6 +1017,8 @@ bool App::UpdateTime(Report::ColumnIndexes column_index) {
 
       ReportFile::SaveReport(const_cast<std::string &>(html));
 
+      ReportRecalculator::RecalculateDayAndUpdate(row_index);
+
       return true;
     }
   }
@@ -920,14 +1028,58 @@ bool App::UpdateTime(Report::ColumnIndexes column_index) {
 
 // Pretty-print report to CLI
 bool App::View() {
+  if (arguments_->json_) {
+    ReportRendererJson renderer_json(&std::cout);
+
+    return arguments_->tail_amount_ > 0
+           ? renderer_json.RenderTail(
+               arguments_->tail_amount_,
+               arguments_->tail_days_,
+               arguments_->GetTaskNumber(),
+               arguments_->GetComment())
+           : renderer_json.Render(
+               static_cast<Report::RenderScopes>(arguments_->render_scope_),
+               arguments_->GetNegativeNumber(),
+               arguments_->GetTaskNumber(),
+               arguments_->GetComment());
+  }
+
   ReportRendererCli renderer;
 
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   if (config.GetConfigValue("clear_before_view") == "1") {
     helper::Tui::ClearConsole();
   }
 
+  if (arguments_->pager_) {
+    ReportPager pager;
+
+    return pager.Page();
+  }
+
+  if (arguments_->watch_) {
+    ReportWatcher watcher;
+
+    // Latest day, unless a tail is given
+    return arguments_->tail_amount_ > 0
+           ? watcher.Watch(
+               arguments_->tail_amount_,
+               arguments_->tail_days_,
+               arguments_->GetTaskNumber(),
+               arguments_->GetComment())
+           : watcher.Watch(
+               1, true, arguments_->GetTaskNumber(), arguments_->GetComment());
+  }
+
+  if (arguments_->tail_amount_ > 0) {
+    return renderer.PrintTailToCli(
+        arguments_->tail_amount_,
+        arguments_->tail_days_,
+        arguments_->GetTaskNumber(),
+        arguments_->GetComment());
+  }
+
   return renderer.PrintToCli(
       static_cast<ReportRendererCli::RenderScopes>(arguments_->render_scope_),
       arguments_->GetNegativeNumber(),
@@ -935,10 +1087,50 @@ bool App::View() {
       arguments_->GetComment());
 }
 
+// Print aggregated durations, arguments: [task|day|week|month|year]
+// [p=<period>] [t=<task>]
+bool App::Stats() {
+  ReportStats::Groups group = ReportStats::Group_Task;
+  std::string period;
+  std::string path_columnar;
+
+  for (int index = 2; index < arguments_->argc_; ++index) {
+    std::string argument = arguments_->argv_[index];
+
+    if (helper::String::StartsWith(argument.c_str(), "p=")) {
+      period = argument.substr(2);
+
+      continue;
+    }
+
+    if (helper::String::StartsWith(argument.c_str(), "f=")) {
+      path_columnar = argument.substr(2);
+
+      continue;
+    }
+
+    ReportStats::Groups group_argument =
+        ReportStats::ResolveGroupByName(argument);
+
+    if (ReportStats::Group_Invalid != group_argument) group = group_argument;
+  }
+
+  return ReportStats::Print(
+      group, period, arguments_->GetTaskNumber(), path_columnar);
+}
+
 bool App::ViewWeek() {
+  if (arguments_->json_) {
+    ReportRendererJson renderer_json(&std::cout);
+
+    return renderer_json.Render(
+        Report::RenderScopes::Scope_Week, arguments_->GetNegativeNumber(),
+        arguments_->GetTaskNumber(), arguments_->GetComment());
+  }
+
   ReportRendererCli renderer;
 
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   if (config.GetConfigValue("clear_before_view") == "1") {
     helper::Tui::ClearConsole();
@@ -960,6 +1152,11 @@ bool App::CsvRecentTaskNumbers() {
   bool is_first = true;
   int amount_task_numbers_found = 0;
 
+  // As JSON: array of strings, like tasks of entries output as JSON
+  const char *quote = arguments_->json_ ? "\"" : "";
+
+  if (arguments_->json_) std::cout << "[";
+
   for (int row_offset = 0;
        amount_task_numbers_found < 30 && row_offset < amount_rows;
        row_offset++) {
@@ -971,7 +1168,7 @@ bool App::CsvRecentTaskNumbers() {
         std::cout << ",";
       }
 
-      std::cout << task_number;
+      std::cout << quote << task_number << quote;
 
       amount_task_numbers_found++;
 
@@ -983,12 +1180,21 @@ bool App::CsvRecentTaskNumbers() {
     }
   }
 
+  if (arguments_->json_) std::cout << "]\n";
+
   delete parser;
 
   return true;
 }
 
 bool App::CsvTodayTracks() {
+  if (arguments_->json_) {
+    ReportRendererJson renderer_json(&std::cout);
+
+    return renderer_json.Render(
+        static_cast<Report::RenderScopes>(arguments_->render_scope_), 0, -1);
+  }
+
   ReportRendererCsv renderer;
 
   return renderer.RenderToStdOut(
@@ -1000,7 +1206,7 @@ bool App::CsvTodayTracks() {
 bool App::BrowseDayTasks() {
   ReportRendererCli renderer;
 
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   if (config.GetConfigValue("clear_before_view") == "1") {
     helper::Tui::ClearConsole();
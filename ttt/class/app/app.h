@@ -35,6 +35,7 @@
 #include <string>
 #include <iostream>
 #include <cstring>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -57,6 +58,9 @@ class App {
 
   static bool ClearTimesheet();
 
+  // Clearing confirmed via argument "y" or key press?
+  [[nodiscard]] bool IsClearTimesheetConfirmed() const;
+
   bool AddFullDayEntry();
 
   bool BrowseTaskUrl();
@@ -65,6 +69,10 @@ class App {
 
   void DisplayDate();
 
+  // Export timesheet to file of format given via --format:
+  // csv, columnar, json or ndjson
+  bool Export();
+
   bool ExportCsv();
 
   void Help();
@@ -102,6 +110,9 @@ class App {
   // Add end-entry
   bool Stop();
 
+  // Print aggregated durations per task, day, week, month or year
+  bool Stats();
+
   // Add/Append/Unset comment of latest or entry with given ID
   bool UpdateComment();
   static bool UpdateCommentByEntryId(
@@ -118,7 +129,7 @@ class App {
   bool ViewWeek();
 
   // Output given amount of recent tasks (having a task-number) as CSV
-  static bool CsvRecentTaskNumbers();
+  bool CsvRecentTaskNumbers();
 
   // Output tracks of current day as CSV
   bool CsvTodayTracks();
@@ -83,6 +83,40 @@ void AppArguments::Resolve(AppCommand &command) {
       continue;
     }
 
+    if (argument == "--pager") {
+      argv_types_[i] = ArgumentType_RenderScope;
+      pager_ = true;
+
+      continue;
+    }
+
+    if (argument == "--watch") {
+      argv_types_[i] = ArgumentType_RenderScope;
+      watch_ = true;
+
+      continue;
+    }
+
+    if (argument == "--json") {
+      argv_types_[i] = ArgumentType_RenderScope;
+      json_ = true;
+
+      continue;
+    }
+
+    if (helper::String::StartsWith(argument.c_str(), "--format=")) {
+      argv_types_[i] = ArgumentType_RenderScope;
+      format_ = argument.substr(std::strlen("--format="));
+
+      continue;
+    }
+
+    if (argument == "--tail") {
+      i = ResolveAsTail(i);
+
+      continue;
+    }
+
     // Try resolve i=<number> or i=<number,number,...>
     if (helper::String::StartsWith(argv_[i], "i=") && ResolveAsIndex(i)) {
       continue;
@@ -168,6 +202,32 @@ bool AppArguments::ResolveAsTime(int i) {
   return true;
 }
 
+// Resolve "--tail [<amount>[d]]", e.g. "--tail 20" = latest 20 rows,
+// "--tail 3d" = latest 3 days. Returns index of its last argument
+int AppArguments::ResolveAsTail(int i) {
+  argv_types_[i] = ArgumentType_RenderScope;
+  tail_amount_ = kDefaultTailAmount;
+
+  if (i + 1 >= argc_ || i + 1 == max_arguments_) return i;
+
+  std::string amount = argv_[i + 1];
+
+  tail_days_ = !amount.empty() && 'd' == amount.back();
+
+  if (tail_days_) amount.pop_back();
+
+  if (!helper::String::IsNumeric(amount)) {
+    tail_days_ = false;
+
+    return i;
+  }
+
+  tail_amount_ = std::max(1, helper::String::ToInt(amount));
+  argv_types_[i + 1] = ArgumentType_Number;
+
+  return i + 1;
+}
+
 // Try resolve i=<number> or i=<number,number,...>
 bool AppArguments::ResolveAsIndex(int i) {
   argument_index_entry_id_ = i;
@@ -201,8 +261,11 @@ bool AppArguments::ResolveAsIndex(int i) {
 void AppArguments::SetArgvDefaultTypeByCommand(AppCommand &command, int index) {
   switch (command.GetResolved()) {
     case AppCommand::Command_Day:
+    case AppCommand::Command_Export:
     case AppCommand::Command_Help:
     case AppCommand::Command_Remove:
+    case AppCommand::Command_Stats:
+    case AppCommand::Command_Status:
     case AppCommand::Command_Version:
     case AppCommand::Command_View:return;
     case AppCommand::Command_Comment:
@@ -33,6 +33,7 @@
 #include <ttt/helper/helper_html.h>
 #include <ttt/helper/helper_string.h>
 
+#include <algorithm>
 #include <string>
 #include <cstring>
 #include <vector>
@@ -56,12 +57,31 @@ class AppArguments {
   char **argv_;
 
   int max_arguments_ = 10;
+
+  // Amount of rows viewed by "--tail" w/o given amount
+  static const int kDefaultTailAmount = 10;
   ArgumentTypes argv_types_[10]{};
 
   int render_scope_ = 0;
   bool all_ = false;
   bool indexed_ = false;
 
+  // Amount of latest rows (or days) to view, 0 = not limited to the tail
+  int tail_amount_ = 0;
+  bool tail_days_ = false;
+
+  // View interactively, paging through the timesheet
+  bool pager_ = false;
+
+  // View latest rows (default: latest day) live, updated upon modifications
+  bool watch_ = false;
+
+  // Output views as JSON
+  bool json_ = false;
+
+  // Format given via "--format=<format>", e.g. of exports
+  std::string format_;
+
   // Was index argument, e.g. "i=1", given at all/which argument-index?
   int argument_index_entry_id_ = -1;
 
@@ -114,6 +134,9 @@ class AppArguments {
   // Try resolve i=<number> or i=<number,number,...>
   bool ResolveAsIndex(int i);
   bool ResolveAsTime(int i);
+
+  // Resolve "--tail [<amount>[d]]", returns index of its last argument
+  int ResolveAsTail(int i);
   void ResolveAsTaskIndex(
       int i,
       const std::string &argument,
@@ -59,6 +59,10 @@ AppCommand::Commands AppCommand::ResolveCommandByName(
     return Command_Start;
   }
 
+  if (command == "st" || command == "status") {
+    return Command_Status;
+  }
+
   if (command == "p" || command == "pause" || command == "stop") {
     return Command_Stop;
   }
@@ -115,6 +119,10 @@ AppCommand::Commands AppCommand::ResolveCommandByName(
     return Command_Undo;
   }
 
+  if (command == "redo") {
+    return Command_Redo;
+  }
+
   if (command == "V" || command == "version") {
     return Command_Version;
   }
@@ -131,6 +139,10 @@ AppCommand::Commands AppCommand::ResolveCommandByName(
     return Command_BrowseDayTasks;
   }
 
+  if (command == "stats") {
+    return Command_Stats;
+  }
+
   if (command == "csvdt") {
     return Command_CsvDayTracks;
   }
@@ -143,6 +155,10 @@ AppCommand::Commands AppCommand::ResolveCommandByName(
     return Command_Csv;
   }
 
+  if (command == "export") {
+    return Command_Export;
+  }
+
   if (command == "cls" || command == "clear") {
     return Command_ClearTimesheet;
   }
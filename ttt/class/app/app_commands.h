@@ -45,13 +45,17 @@ class AppCommand {
     Command_CsvDayTracks,
     Command_Day,
     Command_DisplayDate,
+    Command_Export,
     Command_Help,
     Command_Merge,
     Command_Recalculate,
+    Command_Redo,
     Command_Resume,
     Command_Remove,
     Command_Split,
     Command_Start,
+    Command_Stats,
+    Command_Status,
     Command_Stop,
     Command_Task,
     Command_Undo,
@@ -30,7 +30,7 @@ namespace tictac_track {
 const char AppConfig::kFilename[9] = ".ttt.ini";
 
 // Get object instance.
-// Initialize at 1st call: ensure config file exists, load contents to attribute
+// Initialize at 1st call: store arguments, config is loaded on 1st key access
 AppConfig &AppConfig::GetInstance(char **argv) {
   // Instantiated on first use
   static AppConfig instance;
@@ -42,23 +42,24 @@ AppConfig &AppConfig::GetInstance(char **argv) {
   return instance;
 }
 
-// Create default ".tictac-track.conf"
-// if it does not exist, store to instance property
+// Store arguments, reading of .ttt.ini is deferred until 1st access of a key
 void AppConfig::Init(char **argv) {
   is_initialized_ = true;
 
   if (argv != nullptr) {
     argv_ = argv;
   }
+}
 
-  path_binary_ = helper::System::GetBinaryPath(argv_, 3);
+// Load config from .ttt.ini into map,
+// create default ".ttt.ini" only if it does not exist
+void AppConfig::Load() {
+  // Set before reading: creating the default config resolves values itself
+  is_loaded_ = true;
 
-  std::string path_config_file = path_binary_ + AppConfig::kFilename;
+  std::string path_config_file = GetBinaryPath() + AppConfig::kFilename;
 
-  if (helper::File::FileExists(path_config_file)) {
-    // Load existing config
-    config_file_content_ = helper::File::GetFileContents(path_config_file);
-  } else {
+  if (!helper::File::ReadFile(path_config_file, &config_file_content_)) {
     // Config does not exist: Create default config
     config_file_content_ = GetDefaultConfig();
 
@@ -68,6 +69,15 @@ void AppConfig::Init(char **argv) {
   InitConfigMap();
 }
 
+// Get path of executable, resolved once
+std::string AppConfig::GetBinaryPath() {
+  if (path_binary_.empty()) {
+    path_binary_ = helper::System::GetBinaryPath(argv_, 3);
+  }
+
+  return path_binary_;
+}
+
 // Save given content to file of given name in path of executable
 void AppConfig::SaveConfig(
     const std::string& path_config_file,
@@ -90,7 +100,7 @@ std::string AppConfig::GetDefaultConfig() {
     << "\n"
     << "\n; Absolute directory path to timesheet.html. "
        "If not set: directory where executable is"
-    << "\n;report_path=" << helper::System::GetBinaryPath(argv_, 3)
+    << "\n;report_path=" << GetBinaryPath()
     << "\n"
     << "\n; Maximum gap between entries to be allowed to be merged. "
        "Format: In minutes (if not set: 0)"
@@ -109,6 +119,15 @@ std::string AppConfig::GetDefaultConfig() {
     << "\n; Enforce having set comment before allowing to stop tracking?"
     << "\nrequire_comment_when_stopping_entry=0"
     << "\n"
+    << "\n; Amount of latest modifications that can be undone (if not set: 10)"
+    << "\nundo_depth=10"
+    << "\n"
+    << "\n; Milliseconds to wait while another ttt process uses the timesheet "
+       "(if not set: 3000)"
+    << "\n; 0 = fail immediately. Commands that only read the timesheet "
+       "never wait for each other"
+    << "\nlock_timeout=3000"
+    << "\n"
     << "\n;--------------------------------------------------------------------"
     << "\n; TUI look and feel:"
     << "\n;--------------------------------------------------------------------"
@@ -186,26 +205,32 @@ std::string AppConfig::GetDefaultConfig() {
   return content.str();
 }
 
-// Read config from ttt.ini into associative map
+// Read config from ttt.ini into associative map: single pass over the content,
+// w/o splitting it into intermediary lines
 void AppConfig::InitConfigMap() {
-  config_map_.erase(config_map_.begin(), config_map_.end());
+  config_map_.clear();
 
-  std::vector<std::string> lines = helper::String::Explode(config_file_content_, '\n');
+  const char *content = config_file_content_.c_str();
+  const char *end = content + config_file_content_.size();
 
-  for (const auto& line : lines) {
-    if (helper::String::StartsWith(line.c_str(), ";")) {
-      continue;
-    }
+  for (const char *line = content; line < end;) {
+    auto *line_end = static_cast<const char *>(
+        std::memchr(line, '\n', static_cast<size_t>(end - line)));
 
-    size_t offset_equals = line.find('=');
-    if (offset_equals == std::string::npos) {
-      continue;
-    }
+    if (line_end == nullptr) line_end = end;
+
+    if (*line != ';') {
+      auto *equals = static_cast<const char *>(
+          std::memchr(line, '=', static_cast<size_t>(line_end - line)));
 
-    std::string key = line.substr(0, offset_equals);
-    std::string value = line.substr(offset_equals + 1);
+      if (equals != nullptr) {
+        config_map_.emplace(
+            std::string(line, static_cast<size_t>(equals - line)),
+            std::string(equals + 1, static_cast<size_t>(line_end - equals - 1)));
+      }
+    }
 
-    config_map_.insert(std::make_pair(key, value));
+    line = line_end + 1;
   }
 }
 
@@ -222,6 +247,8 @@ AppConfig::ConfigKeys AppConfig::ResolveOption(const std::string &input) {
   if ("first_task_of_day" == input) return Option_First_Task_Of_Day;
   if ("default_daily_start_time" == input)
     return Option_Default_Daily_Start_Time;
+  if ("undo_depth" == input) return Option_Undo_Depth;
+  if ("lock_timeout" == input) return Option_Lock_Timeout;
 
   return Option_Invalid;
 }
@@ -236,8 +263,11 @@ std::string AppConfig::GetDefaultLanguageKey() {
 
 // Get value of given key from .tictac-track.conf, or default value
 std::string AppConfig::GetConfigValue(const std::string &key) {
-  return 0 == config_map_.count(key) ? GetConfigValueDefault(key)
-                                     : config_map_[key];
+  if (!is_loaded_) Load();
+
+  auto it = config_map_.find(key);
+
+  return it == config_map_.end() ? GetConfigValueDefault(key) : it->second;
 }
 
 // Get instance of config, then get value for given config option
@@ -269,8 +299,9 @@ std::string AppConfig::GetConfigValueDefault(const std::string &key) {
     case Option_Locale_Key:return "en";
     case Option_Id_Column:
     case Option_Max_Mergeable_Gap:return "0";
-    case Option_Report_File_Path:
-      return helper::System::GetBinaryPath(argv_, 3);
+    case Option_Report_File_Path:return GetBinaryPath();
+    case Option_Undo_Depth:return "10";
+    case Option_Lock_Timeout:return "3000";
     case Option_Invalid:
     default:return "";
   }
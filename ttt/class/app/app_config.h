@@ -61,6 +61,8 @@ class AppConfig {
     Option_Max_Mergeable_Gap,
     Option_Report_File_Path,
     Option_First_Task_Of_Day,
+    Option_Undo_Depth,
+    Option_Lock_Timeout,
     Option_Invalid
   };
 
@@ -87,6 +89,9 @@ class AppConfig {
 
   bool is_initialized_ = false;
 
+  // .ttt.ini is read and parsed lazily, on 1st access of any option
+  bool is_loaded_ = false;
+
   std::string config_file_content_;
 
   std::map<std::string, std::string> config_map_;
@@ -94,9 +99,15 @@ class AppConfig {
   // Prevent construction from outside (singleton)
   AppConfig() = default;
 
-  // Create default ".tictac-track.conf" if it does not exist, store in property
+  // Store arguments, reading of config is deferred until 1st access
   void Init(char **argv = nullptr);
 
+  // Load config from .ttt.ini, create default config if it does not exist
+  void Load();
+
+  // Get (cached) path of executable
+  std::string GetBinaryPath();
+
   std::string GetDefaultConfig();
 
   // Save given content to file of given name in binary path
@@ -70,6 +70,11 @@ void AppHelp::PrintHelp(bool withTitle, AppCommand::Commands command) {
 
       return;
     }
+    case AppCommand::Commands::Command_Export: {
+      PrintHelpOnExport();
+
+      return;
+    }
     case AppCommand::Commands::Command_BrowseTaskUrl: {
       PrintHelpOnExternalTaskUrl();
 
@@ -110,6 +115,16 @@ void AppHelp::PrintHelp(bool withTitle, AppCommand::Commands command) {
 
       return;
     }
+    case AppCommand::Commands::Command_Stats:  {
+      PrintHelpOnStats();
+
+      return;
+    }
+    case AppCommand::Commands::Command_Status:  {
+      PrintHelpOnStatus();
+
+      return;
+    }
     case AppCommand::Commands::Command_Stop:  {
       PrintHelpOnStop();
 
@@ -120,6 +135,11 @@ void AppHelp::PrintHelp(bool withTitle, AppCommand::Commands command) {
 
       return;
     }
+    case AppCommand::Commands::Command_Redo:  {
+      PrintHelpOnRedo();
+
+      return;
+    }
     case AppCommand::Commands::Command_Undo:  {
       PrintHelpOnUndo();
 
@@ -131,12 +151,14 @@ void AppHelp::PrintHelp(bool withTitle, AppCommand::Commands command) {
       return;
     }
     case AppCommand::Commands::Command_CsvDayTracks: {
-      std::cout << "csvdt: Output tracked items of current day as CSV.\n";
+      std::cout << "csvdt: Output tracked items of current day as CSV, "
+                   "or w/ --json as JSON.\n";
 
       return;
     }
     case AppCommand::Commands::Command_CsvRecentTaskNumbers: {
-      std::cout << "csvrtn: Output recent (up to) 50 tracked task numbers.\n";
+      std::cout << "csvrtn: Output recent (up to) 50 tracked task numbers, "
+                   "w/ --json as JSON array.\n";
 
       return;
     }
@@ -197,21 +219,28 @@ void AppHelp::PrintOverview() {
     << "\n    merge (m)         - Merge given entry w/ the following entry"
     << "\n    remove (rm)       - "
        "Remove given entry / given amout of latest entries / all entries"
-    << "\n    undo (z)          - Undo last entry creation / modification"
+    << "\n    undo (z)          - Undo last entry creation / modification(s)"
+    << "\n    redo              - Redo last undone modification(s)"
     << "\n    recalculate (rc)  - "
        "Recalculate all duration sums (per entry, per task per day, per day)"
     << "\n    clear (cls)       - Empty the timesheet"
     << "\n"
     << "\n  3. View and export timesheet and tasks:"
     << "\n    browse (b)       - Open timesheet in web browser"
-    << "\n    view (v)         - Display timesheet in commandline"
+    << "\n    view (v)         - Display timesheet in commandline, or as JSON"
     << "\n    week (w)         - Display week out of timesheet in commandline"
     << "\n    csv              - Export timesheet to CSV file"
+    << "\n    export           - "
+       "Export timesheet to CSV, JSON, NDJSON or columnar file"
     << "\n    csvdt            - Output tracked items of current day as CSV"
     << "\n    csvrtn           - Output recent 30 tracked task numbers"
     << "\n    url (u)          - Open external task URL in web browser"
     << "\n    dayTasks (ud)    - "
        "Display tasks of day sequentially in CLI and web browser"
+    << "\n    stats            - "
+       "Display sums, averages etc. of durations per task/day/week/month/year"
+    << "\n    status (st)      - "
+       "Display ongoing entry, day sum and balance, e.g. for prompts"
     << "\n"
     << "\n  4. Meta commands:"
     << "\n    calendarweek (W) - "
@@ -323,6 +352,32 @@ bool AppHelp::PrintHelpOnDay() {
   return true;
 }
 
+bool AppHelp::PrintHelpOnExport() {
+  std::cout
+    << "export: Exports timesheet to CSV, JSON, NDJSON "
+       "or to a columnar binary file."
+    << "\n"
+    << "\nUsage example 1: export                             - "
+       "Export timesheet to CSV file, as csv"
+    << "\nUsage example 2: export --format=columnar           - "
+       "Export timesheet to columnar file, named like the CSV w/ .ttc"
+    << "\nUsage example 3: export --format=columnar all.ttc   - "
+       "Export timesheet to columnar file all.ttc"
+    << "\nUsage example 4: stats month f=all.ttc              - "
+       "Display durations per month, read from all.ttc"
+    << "\nUsage example 5: export --format=json all.json      - "
+       "Export entries, day sums and balances to JSON file all.json"
+    << "\nUsage example 6: export --format=ndjson             - "
+       "Export entries, day sums and balances to NDJSON file"
+    << "\n"
+    << "\nThe columnar file holds one fixed-width array per column "
+       "(dates, start, end, duration, balance, task), "
+       "and is read via mmap w/o parsing."
+    << "\n";
+
+  return true;
+}
+
 bool AppHelp::PrintHelpOnExternalTaskUrl() {
   std::cout
     << "url (u): Opens configured task action URLs in web browser."
@@ -518,9 +573,75 @@ bool AppHelp::PrintHelpOnTask() {
 
 bool AppHelp::PrintHelpOnUndo() {
   std::cout
-    << "undo (z): Reverts the last operation "
-       "(comment, remove, start, stop, task)."
-    << "\n\nPlease note: Only one operation can be undone."
+    << "undo (z): Reverts the last operation(s) "
+       "(comment, remove, start, stop, task, etc.)."
+    << "\n"
+    << "\nUsage example 1: z    - Revert the last operation"
+    << "\nUsage example 2: z 3  - Revert the last three operations"
+    << "\n"
+    << "\nThe amount of operations that can be undone is configured via "
+       "undo_depth (default: 10)."
+    << "\n";
+
+  return true;
+}
+
+bool AppHelp::PrintHelpOnRedo() {
+  std::cout
+    << "redo: Re-applies operation(s) reverted by undo."
+    << "\n"
+    << "\nUsage example 1: redo    - Re-apply the last undone operation"
+    << "\nUsage example 2: redo 3  - Re-apply the last three undone operations"
+    << "\n"
+    << "\nPlease note: Undone operations cannot be redone anymore, "
+       "after any other modification of the timesheet."
+    << "\n";
+
+  return true;
+}
+
+bool AppHelp::PrintHelpOnStats() {
+  std::cout
+    << "stats: Displays amount, sum, average, minimum and maximum of entries' "
+       "durations, grouped by task, day, week, month or year, and the "
+       "balance at the end of each period."
+    << "\n"
+    << "\nUsage example 1: stats                   - "
+       "Display durations per task, of all entries"
+    << "\nUsage example 2: stats task p=2020/03    - "
+       "Display durations per task, of March 2020"
+    << "\nUsage example 3: stats month p=2020      - "
+       "Display durations per month, of 2020"
+    << "\nUsage example 4: stats week t=123        - "
+       "Display durations of task 123 per week"
+    << "\nUsage example 5: stats day p=2020/01-2020/03 - "
+       "Display durations per day, of January until March 2020"
+    << "\n"
+    << "\nPeriods: p=<yyyy>[/<mm>[/<dd>]], or ranges of those: "
+       "p=<from>-<to>."
+    << "\nDurations of ongoing entries are counted until the current time."
+    << "\nWeekly and monthly totals are kept in timesheet.html.rollups, "
+       "updated by every modification once created."
+    << "\n";
+
+  return true;
+}
+
+bool AppHelp::PrintHelpOnStatus() {
+  std::cout
+    << "status (st): Displays the ongoing entry, today's sum and the balance."
+    << "\n"
+    << "\nUsage example 1: st          - "
+       "Display e.g. \"Ongoing task 123, 01:42 elapsed, today 06:10, "
+       "balance +03:20\""
+    << "\nUsage example 2: st \"%t %e\" - "
+       "Display task and elapsed time of the ongoing entry"
+    << "\n"
+    << "\nPlaceholders: %t task, %c comment, %s start-time, "
+       "%e elapsed time of the ongoing entry, %d today's sum, %b balance, "
+       "%% percent sign."
+    << "\nThe status is read from a small file next to the timesheet, "
+       "which is updated by every modification."
     << "\n";
 
   return true;
@@ -557,6 +678,24 @@ bool AppHelp::PrintHelpOnView() {
     << "\nUsage example 14: v w -1 t=123 c=foo - "
        "Display entries of task 123 of previous week "
        "with \"foo\" inside the comment"
+    << "\nUsage example 15: v --tail 20        - "
+       "Display latest 20 entries, w/o reading the whole timesheet"
+    << "\nUsage example 16: v --tail 3d        - "
+       "Display entries of latest 3 days, w/o reading the whole timesheet"
+    << "\nUsage example 17: v --pager          - "
+       "Page through the timesheet full-screen, starting at its end."
+    << "\n                                       "
+       "Keys: j/k or arrows: line, space/b: page, d/D: day, w/W: week,"
+    << "\n                                       "
+       "t/T: task of topmost entry, g/G: start/end, q: quit"
+    << "\nUsage example 18: v --watch          - "
+       "Display entries of latest day, updated live upon modifications"
+    << "\n                                       "
+       "and once per minute. Combinable w/ --tail. Key: q: quit"
+    << "\nUsage example 19: v d --json         - "
+       "Output entries, day sums and balances of current day as JSON."
+    << "\n                                       "
+       "Combinable w/ all filters above, except --pager and --watch"
     << "\n";
 
   return true;
@@ -581,8 +720,9 @@ bool AppHelp::PrintHelpOnWeek() {
   std::cout
     << "week (w): Displays week out of timesheet in command-line."
     << "\n"
-    << "\nUsage example 1:  w    - Display current week of timesheet"
-    << "\nUsage example 2:  w -1 - Display previous week of timesheet"
+    << "\nUsage example 1:  w        - Display current week of timesheet"
+    << "\nUsage example 2:  w -1     - Display previous week of timesheet"
+    << "\nUsage example 3:  w --json - Output current week of timesheet as JSON"
     << "\n";
 
   return true;
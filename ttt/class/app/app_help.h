@@ -57,14 +57,18 @@ class AppHelp {
   static bool PrintHelpOnDay();
   static bool PrintHelpOnDisplayCalendarWeek();
   static bool PrintHelpOnDisplayDate();
+  static bool PrintHelpOnExport();
   static bool PrintHelpOnExternalTaskUrl();
   static bool PrintHelpOnHelp();
   static bool PrintHelpOnMerge();
   static bool PrintHelpOnRecalculate();
+  static bool PrintHelpOnRedo();
   static bool PrintHelpOnResume();
   static bool PrintHelpOnRemove();
   static bool PrintHelpOnSplit();
   static bool PrintHelpOnStart();
+  static bool PrintHelpOnStats();
+  static bool PrintHelpOnStatus();
   static bool PrintHelpOnStop();
   static bool PrintHelpOnTask();
   static bool PrintHelpOnUndo();
@@ -37,7 +37,7 @@ AppLocale &AppLocale::GetInstance() {
 }
 
 void AppLocale::Init() {
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   locale_key_ = config.GetConfigValue("locale").c_str();
   active_dictionary_ = GetDictionaryByLocaleKey();
@@ -28,8 +28,24 @@
 
 namespace tictac_track {
 
+bool ReportBackup::is_recording_ = false;
+std::vector<ReportBackup::Change> ReportBackup::changes_;
+uint64_t ReportBackup::sequence_ = 0;
+size_t ReportBackup::amount_snapshots_ = 0;
+
 bool ReportBackup::BackupReportBeforeProcessCommand(
     AppCommand::Commands kCommand) {
+  if (!IsModifyingCommand(kCommand)) return false;
+
+  is_recording_ = true;
+  changes_.clear();
+  sequence_ = LoadIndex().current;
+  amount_snapshots_ = 0;
+
+  return true;
+}
+
+bool ReportBackup::IsModifyingCommand(AppCommand::Commands kCommand) {
   switch (kCommand) {
     case AppCommand::Command_ClearTimesheet:
     case AppCommand::Command_Comment:
@@ -42,16 +58,19 @@ bool ReportBackup::BackupReportBeforeProcessCommand(
     case AppCommand::Command_Start:
     case AppCommand::Command_Stop:
     case AppCommand::Command_Task:
-      ReportBackup::BackupReportTemporary();
       return true;
     case AppCommand::Command_BrowseTimesheet:
     case AppCommand::Command_BrowseTaskUrl:
     case AppCommand::Command_DisplayCalendarWeek:
     case AppCommand::Command_Csv:
     case AppCommand::Command_DisplayDate:
+    case AppCommand::Command_Export:
     case AppCommand::Command_Help:
     case AppCommand::Command_CsvRecentTaskNumbers:
     case AppCommand::Command_CsvDayTracks:
+    case AppCommand::Command_Redo:
+    case AppCommand::Command_Stats:
+    case AppCommand::Command_Status:
     case AppCommand::Command_Undo:
     case AppCommand::Command_Version:
     case AppCommand::Command_View:
@@ -63,79 +82,539 @@ bool ReportBackup::BackupReportBeforeProcessCommand(
   }
 }
 
-// Backup timesheet.html to timesheet.html.bak.tmp
-bool ReportBackup::BackupReportTemporary() {
-  AppConfig &config = AppConfig::GetInstance();
-  std::string report_file_path = config.GetReportFilePath();
+bool ReportBackup::IsRecording() {
+  return is_recording_;
+}
 
-  if (!helper::File::FileExists(report_file_path)) {
-    return false;
+// Get lowest offset of the recorded changes, not counting those ending
+// before given offset. Offsets of changes are those in the new content
+size_t ReportBackup::GetOffsetFirstChange(size_t offset_min) {
+  size_t offset_first = std::string::npos;
+
+  for (const Change &change : changes_) {
+    if (change.is_snapshot) return 0;
+
+    if (change.offset + change.content_new.size() < offset_min) continue;
+
+    offset_first = std::min(offset_first, change.offset);
+  }
+
+  return offset_first;
+}
+
+// Record replacement of given old by given new content at given offset.
+// Offsets of successive changes of one command refer to the content
+// resulting from the previous change
+bool ReportBackup::RecordChange(
+    size_t offset,
+    const std::string &content_old,
+    const std::string &content_new,
+    size_t len_max) {
+  if (!is_recording_) return true;
+
+  size_t len_old = content_old.size();
+  size_t len_new = content_new.size();
+  size_t len_min = std::min(len_old, len_new);
+
+  const char *data_old = content_old.data();
+  const char *data_new = content_new.data();
+
+  // Skip equal blocks via memcmp, then compare the remaining bytes singly
+  size_t len_prefix = 0;
+
+  while (len_prefix + kLenCompareBlock <= len_min
+      && 0 == std::memcmp(
+          data_old + len_prefix, data_new + len_prefix, kLenCompareBlock)) {
+    len_prefix += kLenCompareBlock;
+  }
+
+  while (len_prefix < len_min
+      && data_old[len_prefix] == data_new[len_prefix]) {
+    ++len_prefix;
+  }
+
+  if (len_prefix == len_old && len_prefix == len_new) return true;
+
+  size_t len_suffix = 0;
+
+  while (len_suffix + kLenCompareBlock <= len_min - len_prefix
+      && 0 == std::memcmp(
+          data_old + len_old - len_suffix - kLenCompareBlock,
+          data_new + len_new - len_suffix - kLenCompareBlock,
+          kLenCompareBlock)) {
+    len_suffix += kLenCompareBlock;
+  }
+
+  while (len_suffix < len_min - len_prefix
+      && data_old[len_old - 1 - len_suffix]
+          == data_new[len_new - 1 - len_suffix]) {
+    ++len_suffix;
+  }
+
+  std::string_view middle_old =
+      std::string_view(content_old).substr(
+          len_prefix, len_old - len_prefix - len_suffix);
+
+  std::string_view middle_new =
+      std::string_view(content_new).substr(
+          len_prefix, len_new - len_prefix - len_suffix);
+
+  std::vector<Change> changes;
+
+  if (middle_old.size() + middle_new.size() < kMinLenDiffLines
+      || !AppendChangesOfLines(
+          offset + len_prefix, middle_old, middle_new, &changes)) {
+    changes.push_back({
+        offset + len_prefix,
+        std::string(middle_old),
+        std::string(middle_new)});
   }
 
-  std::string filename_bak = report_file_path + ".bak";
+  size_t len_changes = 0;
 
-  std::ifstream src(report_file_path, std::ios::binary);
-  std::ofstream dst(filename_bak, std::ios::binary);
+  for (const Change &change : changes) {
+    len_changes += change.content_old.size() + change.content_new.size();
+  }
 
-  dst << src.rdbuf();
+  if (len_changes > len_max) return false;
+
+  std::move(changes.begin(), changes.end(), std::back_inserter(changes_));
 
   return true;
 }
 
-// Remove timesheet.html.bak, rename timesheet.html.bak to timesheet.html.bak
-bool ReportBackup::ActivateTemporaryBackup() {
-  AppConfig &config = AppConfig::GetInstance();
-  std::string path_report_file = config.GetReportFilePath();
+// Keep the timesheet file as a whole: via reflink or hard link if possible
+bool ReportBackup::RecordSnapshot(const std::string &path_report) {
+  if (!is_recording_) return true;
+
+  // Remove redoable record of same sequence number, its snapshots would clash
+  if (0 == amount_snapshots_) RemoveRecord(sequence_);
 
-  if (!helper::File::FileExists(path_report_file)) {
+  if (helper::File::PreserveMethod_Failed == helper::File::PreserveFile(
+      path_report,
+      GetPathSnapshot(sequence_, amount_snapshots_, true))) {
     return false;
   }
 
-  std::string path_backup_file = path_report_file + ".bak";
-  std::string path_backup_tmp = path_backup_file + ".tmp";
+  Change change{};
+  change.is_snapshot = true;
+  change.index_snapshot = amount_snapshots_++;
 
-  if (!helper::File::FileExists(path_backup_tmp)) {
-    return false;
+  changes_.push_back(change);
+
+  return true;
+}
+
+// Split given differing contents into lines and record only the differing
+// ranges of lines, found via Myers' O(ND) diff algorithm. Returns false
+// (w/o recording anything) if more than kMaxDiffEdits lines differ
+bool ReportBackup::AppendChangesOfLines(
+    size_t offset,
+    std::string_view content_old,
+    std::string_view content_new,
+    std::vector<Change> *changes) {
+  std::vector<std::string_view> lines_old = SplitLines(content_old);
+  std::vector<std::string_view> lines_new = SplitLines(content_new);
+
+  auto amount_old = static_cast<int>(lines_old.size());
+  auto amount_new = static_cast<int>(lines_new.size());
+
+  int max_edits = std::min(amount_old + amount_new, kMaxDiffEdits);
+
+  // Furthest reaching x (= index in old lines) per diagonal k = x - y,
+  // stored before each step d, for backtracking
+  std::vector<int> furthest(2 * max_edits + 3, 0);
+  std::vector<std::vector<int>> trace;
+
+  int offset_k = max_edits + 1;
+  int amount_edits = -1;
+
+  for (int d = 0; d <= max_edits && -1 == amount_edits; ++d) {
+    trace.push_back(furthest);
+
+    for (int k = -d; k <= d; k += 2) {
+      int x = k == -d
+          || (k != d && furthest[offset_k + k - 1] < furthest[offset_k + k + 1])
+        ? furthest[offset_k + k + 1]
+        : furthest[offset_k + k - 1] + 1;
+
+      int y = x - k;
+
+      while (x < amount_old && y < amount_new
+          && lines_old[x] == lines_new[y]) {
+        ++x;
+        ++y;
+      }
+
+      furthest[offset_k + k] = x;
+
+      if (x >= amount_old && y >= amount_new) {
+        amount_edits = d;
+
+        break;
+      }
+    }
+  }
+
+  if (-1 == amount_edits) return false;
+
+  // Backtrack: collect pairs of equal lines, from the end
+  std::vector<std::pair<int, int>> equal_lines;
+
+  int x = amount_old;
+  int y = amount_new;
+
+  for (int d = amount_edits; d >= 0; --d) {
+    const std::vector<int> &furthest_before = trace[d];
+    int k = x - y;
+
+    int k_previous = 0;
+    int x_previous = 0;
+    int y_previous = 0;
+
+    if (d > 0) {
+      k_previous = k == -d
+          || (k != d
+              && furthest_before[offset_k + k - 1]
+                  < furthest_before[offset_k + k + 1])
+        ? k + 1
+        : k - 1;
+
+      x_previous = furthest_before[offset_k + k_previous];
+      y_previous = x_previous - k_previous;
+    }
+
+    while (x > x_previous && y > y_previous) {
+      equal_lines.emplace_back(--x, --y);
+    }
+
+    x = x_previous;
+    y = y_previous;
+  }
+
+  // Record ranges between equal lines, at their offset in the new content
+  equal_lines.emplace(equal_lines.begin(), amount_old, amount_new);
+
+  auto get_offset = [](
+      const std::vector<std::string_view> &lines,
+      std::string_view content,
+      int index) {
+    return index < static_cast<int>(lines.size())
+        ? static_cast<size_t>(lines[index].data() - content.data())
+        : content.size();
+  };
+
+  int index_old = 0;
+  int index_new = 0;
+
+  for (auto iter = equal_lines.rbegin(); iter != equal_lines.rend(); ++iter) {
+    if (iter->first > index_old || iter->second > index_new) {
+      size_t start_old = get_offset(lines_old, content_old, index_old);
+      size_t start_new = get_offset(lines_new, content_new, index_new);
+
+      changes->push_back({
+          offset + start_new,
+          std::string(content_old.substr(
+              start_old,
+              get_offset(lines_old, content_old, iter->first) - start_old)),
+          std::string(content_new.substr(
+              start_new,
+              get_offset(lines_new, content_new, iter->second) - start_new))});
+    }
+
+    index_old = iter->first + 1;
+    index_new = iter->second + 1;
+  }
+
+  return true;
+}
+
+// Split given content into lines, each incl. its trailing newline
+std::vector<std::string_view> ReportBackup::SplitLines(
+    std::string_view content) {
+  std::vector<std::string_view> lines;
+
+  size_t offset = 0;
+
+  while (offset < content.size()) {
+    size_t offset_newline = content.find('\n', offset);
+
+    size_t offset_end = std::string_view::npos == offset_newline
+        ? content.size()
+        : offset_newline + 1;
+
+    lines.push_back(content.substr(offset, offset_end - offset));
+
+    offset = offset_end;
+  }
+
+  return lines;
+}
+
+// Store recorded changes as newest history record
+bool ReportBackup::CommitChanges() {
+  is_recording_ = false;
+
+  if (changes_.empty()) return true;
+
+  HistoryIndex index = LoadIndex();
+
+  // Modifying after undo: undone records cannot be redone anymore
+  if (0 == amount_snapshots_) RemoveRecord(index.current);
+
+  for (uint64_t sequence = index.current + 1;
+       sequence < index.last;
+       ++sequence) {
+    RemoveRecord(sequence);
+  }
+
+  if (!SaveRecord(index.current, changes_)) return false;
+
+  changes_.clear();
+
+  index.last = ++index.current;
+
+  auto depth = static_cast<uint64_t>(std::max(1, helper::String::ToInt(
+      AppConfig::GetConfigValueStatic("undo_depth"))));
+
+  while (index.current - index.first > depth) {
+    RemoveRecord(index.first++);
+  }
+
+  return SaveIndex(index);
+}
+
+// Revert given amount of latest modifications, as far as recorded
+bool ReportBackup::Undo(int amount) {
+  return ApplyRecords(amount, true);
+}
+
+// Re-apply given amount of undone modifications, as far as recorded
+bool ReportBackup::Redo(int amount) {
+  return ApplyRecords(amount, false);
+}
+
+bool ReportBackup::ApplyRecords(int amount, bool revert) {
+  HistoryIndex index = LoadIndex();
+
+  if (amount < 1
+      || (revert && index.current <= index.first)
+      || (!revert && index.current >= index.last)) {
+    return tictac_track::AppError::PrintError(
+        revert ? "Cannot undo." : "Cannot redo.");
   }
 
-  if (helper::File::FileExists(path_backup_file)) {
-    std::remove(path_backup_file.c_str());
+  std::string html = ReportFile::GetReportHtml();
+  std::vector<Change> changes;
+
+  for (; amount > 0
+           && (revert ? index.current > index.first : index.current < index.last);
+       --amount) {
+    uint64_t sequence = revert ? index.current - 1 : index.current;
+
+    if (!LoadRecord(sequence, &changes)
+        || !ApplyRecord(sequence, changes, revert, &html)) {
+      return tictac_track::AppError::PrintError(
+          revert
+          ? "Cannot undo: Timesheet has been modified outside of ttt."
+          : "Cannot redo: Timesheet has been modified outside of ttt.");
+    }
+
+    if (revert) {
+      --index.current;
+    } else {
+      ++index.current;
+    }
   }
 
-  return static_cast<bool>(
-      std::rename(
-          path_backup_tmp.c_str(),
-          path_backup_file.c_str()));
+  return ReportFile::SaveReport(html) && SaveIndex(index);
 }
 
-// Remove timesheet.html.bak.tmp
-bool ReportBackup::RemoveTemporaryBackup() {
-  AppConfig &config = AppConfig::GetInstance();
-  std::string path_report_file = config.GetReportFilePath();
+// Apply changes of given record to given HTML. Fails if the content to be
+// replaced differs from the recorded one
+bool ReportBackup::ApplyRecord(
+    uint64_t sequence,
+    const std::vector<Change> &changes,
+    bool revert,
+    std::string *html) {
+  std::string path_report = AppConfig::GetInstance().GetReportFilePath();
+
+  for (size_t i = 0; i < changes.size(); ++i) {
+    const Change &change = changes[revert ? changes.size() - 1 - i : i];
+
+    if (change.is_snapshot) {
+      // Swap snapshot and timesheet, keeping the current one for redo/undo
+      std::string path_restore =
+          GetPathSnapshot(sequence, change.index_snapshot, revert);
+
+      // Replace the target of a symlinked timesheet, w/ its mode
+      std::string path_real = helper::File::GetRealPath(path_report);
+      struct stat file_stat{};
+
+      if (!helper::File::FileExists(path_restore)
+          || !ReportFile::SaveReport(*html)
+          || helper::File::PreserveMethod_Failed == helper::File::PreserveFile(
+              path_report,
+              GetPathSnapshot(sequence, change.index_snapshot, !revert))
+          || 0 != stat(path_real.c_str(), &file_stat)
+          || 0 != chmod(path_restore.c_str(), file_stat.st_mode & 07777)
+          || 0 != std::rename(path_restore.c_str(), path_real.c_str())) {
+        return false;
+      }
+
+      if (!helper::File::ReadFile(path_report, html)) return false;
 
-  std::string path_tmp_backup = path_report_file + ".bak.tmp";
-  std::remove(path_tmp_backup.c_str());
+      continue;
+    }
+
+    const std::string &content_from =
+        revert ? change.content_new : change.content_old;
+
+    const std::string &content_to =
+        revert ? change.content_old : change.content_new;
+
+    if (change.offset + content_from.size() > html->size()
+        || 0 != html->compare(
+            change.offset, content_from.size(), content_from)) {
+      return false;
+    }
+
+    html->replace(change.offset, content_from.size(), content_to);
+  }
 
   return true;
 }
 
-// Overwrite timesheet.html with timesheet.html.bak
-bool ReportBackup::RestoreBackup() {
-  AppConfig &config = AppConfig::GetInstance();
-  std::string path_report_file = config.GetReportFilePath();
-  std::string path_backup = path_report_file + ".bak";
+std::string ReportBackup::GetPathHistory() {
+  return AppConfig::GetInstance().GetReportFilePath() + ".undo";
+}
 
-  if (!helper::File::FileExists(path_backup)) {
-    return tictac_track::AppError::PrintError("Cannot undo.");
+std::string ReportBackup::GetPathRecord(uint64_t sequence) {
+  return GetPathHistory() + "." + std::to_string(sequence);
+}
+
+std::string ReportBackup::GetPathSnapshot(
+    uint64_t sequence,
+    size_t index_snapshot,
+    bool is_old) {
+  return GetPathRecord(sequence)
+      + "." + std::to_string(index_snapshot)
+      + (is_old ? ".old" : ".new");
+}
+
+// Load sequence numbers from timesheet.html.undo, all 0 if there is none
+ReportBackup::HistoryIndex ReportBackup::LoadIndex() {
+  HistoryIndex index;
+
+  std::ifstream file(GetPathHistory());
+
+  if (!(file >> index.first >> index.current >> index.last)
+      || index.first > index.current
+      || index.current > index.last) {
+    return HistoryIndex();
+  }
+
+  return index;
+}
+
+bool ReportBackup::SaveIndex(const HistoryIndex &index) {
+  std::ofstream file(GetPathHistory(), std::ios::trunc);
+
+  file << index.first << " " << index.current << " " << index.last << "\n";
+
+  return static_cast<bool>(file);
+}
+
+// Record format: amount of changes, then per change: line w/ offset,
+// length of old and of new content, followed by both contents.
+// Snapshots are listed as line: "s <index>"
+bool ReportBackup::SaveRecord(
+    uint64_t sequence,
+    const std::vector<Change> &changes) {
+  std::ofstream file(
+      GetPathRecord(sequence),
+      std::ios::binary | std::ios::trunc);
+
+  file << changes.size() << "\n";
+
+  for (const Change &change : changes) {
+    if (change.is_snapshot) {
+      file << "s " << change.index_snapshot << "\n";
+
+      continue;
+    }
+
+    file
+      << change.offset << " "
+      << change.content_old.size() << " "
+      << change.content_new.size() << "\n"
+      << change.content_old
+      << change.content_new;
   }
 
-  std::ifstream src(path_backup, std::ios::binary);
-  std::ofstream dst(path_report_file, std::ios::binary);
-  dst << src.rdbuf();
+  return static_cast<bool>(file);
+}
+
+bool ReportBackup::LoadRecord(uint64_t sequence, std::vector<Change> *changes) {
+  std::ifstream file(GetPathRecord(sequence), std::ios::binary);
+
+  size_t amount_changes;
+
+  if (!(file >> amount_changes)) return false;
+
+  changes->assign(amount_changes, Change());
 
-  std::remove(path_backup.c_str());
+  for (Change &change : *changes) {
+    std::string token;
+
+    if (!(file >> token)) return false;
+
+    if ("s" == token) {
+      change.is_snapshot = true;
+
+      if (!(file >> change.index_snapshot)) return false;
+
+      continue;
+    }
+
+    change.offset = std::strtoull(token.c_str(), nullptr, 10);
+
+    size_t len_old, len_new;
+
+    if (!(file >> len_old >> len_new)) return false;
+
+    // Skip newline after lengths
+    file.get();
+
+    change.content_old.resize(len_old);
+    change.content_new.resize(len_new);
+
+    if (!file.read(&change.content_old[0], len_old)
+        || !file.read(&change.content_new[0], len_new)) {
+      return false;
+    }
+  }
 
   return true;
 }
 
+// Remove given record, incl. its snapshots
+void ReportBackup::RemoveRecord(uint64_t sequence) {
+  std::vector<Change> changes;
+
+  if (LoadRecord(sequence, &changes)) {
+    for (const Change &change : changes) {
+      if (!change.is_snapshot) continue;
+
+      std::remove(
+          GetPathSnapshot(sequence, change.index_snapshot, true).c_str());
+
+      std::remove(
+          GetPathSnapshot(sequence, change.index_snapshot, false).c_str());
+    }
+  }
+
+  std::remove(GetPathRecord(sequence).c_str());
+}
+
 }  // namespace tictac_track
@@ -29,28 +29,141 @@
 
 #include <ttt/class/app/app_commands.h>
 #include <ttt/class/app/app_config.h>
+#include <ttt/class/app/app_error.h>
 #include <ttt/class/report/report_file.h>
 
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace tictac_track {
 
+// Undo/redo history of timesheet modifications.
+// Every modifying command is stored as a record of the changed byte ranges
+// (timesheet.html.undo.<sequence>), instead of a copy of the whole timesheet.
+// Large changes instead keep the replaced timesheet file as a snapshot
+// (timesheet.html.undo.<sequence>.<index>.old, .new once undone), preserved
+// via reflink or hard link where the filesystem allows, w/o copying.
+// timesheet.html.undo holds the sequence numbers of the oldest record, of the
+// next record to be undone + 1 and of the newest (redoable) record + 1.
+// The amount of kept records is configured via undo_depth
 class ReportBackup {
  public:
+  // Min. length of changed content to be recorded as snapshot
+  static constexpr size_t kMinLenSnapshot = 65536;
+
+  // Start recording changes, if the given command modifies the timesheet
   static bool BackupReportBeforeProcessCommand(AppCommand::Commands kCommand);
 
-  // Remove timesheet.html.bak, rename timesheet.html.bak to timesheet.html.bak
-  static bool ActivateTemporaryBackup();
+  // Is given command one that modifies the timesheet (and is recorded)?
+  static bool IsModifyingCommand(AppCommand::Commands kCommand);
+
+  static bool IsRecording();
+
+  // Get lowest offset of the recorded (not yet committed) changes, not
+  // counting those ending before given offset. std::string::npos if nothing
+  // changed, 0 if the timesheet was recorded as a whole (snapshot)
+  static size_t GetOffsetFirstChange(size_t offset_min = 0);
+
+  // Record replacement of given old by given new content at given offset.
+  // Only the differing parts of both are kept. Returns false w/o recording,
+  // if they are longer than given max. length
+  static bool RecordChange(
+      size_t offset,
+      const std::string &content_old,
+      const std::string &content_new,
+      size_t len_max = std::string::npos);
+
+  // Keep the timesheet file at given path as a whole, before it is replaced
+  // (via helper::File::ReplaceFile, as it can be hard-linked)
+  static bool RecordSnapshot(const std::string &path_report);
+
+  // Store recorded changes as newest history record, drop redoable records
+  // and records exceeding the configured depth
+  static bool CommitChanges();
+
+  // Revert given amount of latest (not yet undone) modifications
+  static bool Undo(int amount = 1);
+
+  // Re-apply given amount of undone modifications
+  static bool Redo(int amount = 1);
+
+ private:
+  struct Change {
+    size_t offset;
+    std::string content_old;
+    std::string content_new;
+    bool is_snapshot = false;
+    size_t index_snapshot = 0;
+  };
+
+  struct HistoryIndex {
+    uint64_t first = 0;
+    uint64_t current = 0;
+    uint64_t last = 0;
+  };
+
+  // Length of blocks compared at once when skipping equal content
+  static constexpr size_t kLenCompareBlock = 256;
+  // Min. length of changed content to be diffed line-wise
+  static constexpr size_t kMinLenDiffLines = 1024;
+  // Max. amount of added + removed lines to be diffed, more are stored as
+  // one change. Keeps the diff's time and memory bound
+  static constexpr int kMaxDiffEdits = 512;
+
+  static bool is_recording_;
+  static std::vector<Change> changes_;
+
+  // Sequence number and amount of snapshots of the record being recorded
+  static uint64_t sequence_;
+  static size_t amount_snapshots_;
+
+  static bool AppendChangesOfLines(
+      size_t offset,
+      std::string_view content_old,
+      std::string_view content_new,
+      std::vector<Change> *changes);
+
+  static std::vector<std::string_view> SplitLines(std::string_view content);
+
+  static std::string GetPathHistory();
+  static std::string GetPathRecord(uint64_t sequence);
+  static std::string GetPathSnapshot(
+      uint64_t sequence,
+      size_t index_snapshot,
+      bool is_old);
+
+  static HistoryIndex LoadIndex();
+  static bool SaveIndex(const HistoryIndex &index);
+
+  static bool SaveRecord(uint64_t sequence, const std::vector<Change> &changes);
+  static bool LoadRecord(uint64_t sequence, std::vector<Change> *changes);
 
-  // Remove timesheet.html.bak.tmp
-  static bool RemoveTemporaryBackup();
+  // Remove given record, incl. its snapshots
+  static void RemoveRecord(uint64_t sequence);
 
-  // Overwrite timesheet.html with timesheet.html.bak
-  static bool RestoreBackup();
+  // Undo or redo given amount of records
+  static bool ApplyRecords(int amount, bool revert);
 
-  // Backup timesheet.html to timesheet.html.bak.tmp
-  static bool BackupReportTemporary();
+  // Apply changes of given record to given HTML, backwards (undo) or forwards.
+  // Snapshots are swapped w/ the timesheet file
+  static bool ApplyRecord(
+      uint64_t sequence,
+      const std::vector<Change> &changes,
+      bool revert,
+      std::string *html);
 };
 
 }  // namespace tictac_track
@@ -32,42 +32,63 @@ ReportBrowser::ReportBrowser() = default;
 
 // Open URL (dafault: timesheet) in web browser
 void ReportBrowser::BrowseTimesheet(std::string url) {
-  AppConfig &config = AppConfig::GetInstance();
-  std::string report_file_path = config.GetReportFilePath();
-
   if (url.empty()) {
-    url = "file://" + report_file_path;
+    AppConfig &config = AppConfig::GetInstance();
+
+    url = "file://" + config.GetReportFilePath();
   }
 
+  BrowseUrls({url});
+}
+
+// Open all given URLs w/ a single invocation of the web browser
+bool ReportBrowser::BrowseUrls(const std::vector<std::string> &urls) {
   if (helper::System::kOsName == "linux"
       || helper::System::kOsName == "unix") {
-    BrowseOnLinux(url);
-  } else if (helper::System::kOsName == "macOs") {
-    BrowseOnMac(url);
+    return BrowseOnLinux(urls);
   }
+
+  if (helper::System::kOsName == "macOs") return BrowseOnMac(urls);
+
+  return false;
 }
 
-void ReportBrowser::BrowseOnLinux(std::string &url) {
-  AppConfig config = AppConfig::GetInstance();
-  std::string cmd = config.GetConfigValue("browser") + " " + url;
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-  system(cmd.c_str());
-#pragma clang diagnostic pop
+// Launch configured browser (can contain arguments, e.g. "firefox -new-tab")
+bool ReportBrowser::BrowseOnLinux(const std::vector<std::string> &urls) {
+  AppConfig &config = AppConfig::GetInstance();
+  std::string browser = config.GetConfigValue("browser");
+
+  std::vector<std::string> arguments;
+
+  std::istringstream browser_stream(browser);
+  std::string argument;
+  while (browser_stream >> argument) arguments.push_back(argument);
+
+  arguments.insert(arguments.end(), urls.begin(), urls.end());
+
+  if (!helper::System::Spawn(arguments)) {
+    return tictac_track::AppError::PrintError(
+        std::string("Failed to launch browser: ").append(browser).c_str());
+  }
+
+  return true;
 }
 
-void ReportBrowser::BrowseOnMac(std::string &url) {
-  std::string cmd = "open " + url;
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-  system(cmd.c_str());
-#pragma clang diagnostic pop
+bool ReportBrowser::BrowseOnMac(const std::vector<std::string> &urls) {
+  std::vector<std::string> arguments = {"open"};
+  arguments.insert(arguments.end(), urls.begin(), urls.end());
+
+  if (!helper::System::Spawn(arguments)) {
+    return tictac_track::AppError::PrintError("Failed to launch browser.");
+  }
+
+  return true;
 }
 
 bool ReportBrowser::BrowseTaskUrl(
     int task_number,
     const std::string& url_command) {
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   std::string url_raw = config.GetConfigValue(url_command);
 
@@ -93,7 +114,7 @@ bool ReportBrowser::BrowseIssueUrlsInScope(
     int task_number,
     const std::string& url_command
 ) {
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   std::string url_raw = config.GetConfigValue(url_command);
   if (url_raw.empty()) {
@@ -124,18 +145,18 @@ bool ReportBrowser::BrowseIssueUrlsInScope(
               .c_str());
     }
 
+    std::vector<std::string> urls;
+
     for (auto const &issue : issues) {
       std::cout << issue << " ";
 
-      std::string url = helper::String::ReplaceAll(
+      urls.push_back(helper::String::ReplaceAll(
           url_raw.c_str(),
           "#TASK#",
-          issue.c_str());
-
-      BrowseTimesheet(url);
+          issue.c_str()));
     }
 
-    return true;
+    return BrowseUrls(urls);
   }
 
   std::string task = task_number > 0
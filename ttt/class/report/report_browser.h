@@ -33,6 +33,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,9 @@ class ReportBrowser : public Report {
   // Open URL (default: timesheet) in web browser
   static void BrowseTimesheet(std::string url = "");
 
+  // Open all given URLs w/ a single invocation of the web browser
+  static bool BrowseUrls(const std::vector<std::string> &urls);
+
   // Open configured task action URL in web browser
   static bool BrowseTaskUrl(
       int task_number,
@@ -60,8 +64,8 @@ class ReportBrowser : public Report {
       const std::string& url_command = "url.default");
 
  private:
-  static void BrowseOnLinux(std::string &url);
-  static void BrowseOnMac(std::string &url);
+  static bool BrowseOnLinux(const std::vector<std::string> &urls);
+  static bool BrowseOnMac(const std::vector<std::string> &urls);
 };
 
 }  // namespace tictac_track
@@ -0,0 +1,291 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_columnar.h>
+
+namespace tictac_track {
+
+ReportColumnar::~ReportColumnar() {
+  if (nullptr != data_) munmap(const_cast<char *>(data_), size_);
+}
+
+// Export all rows of the timesheet to given file
+bool ReportColumnar::Export(const std::string &path) {
+  std::string html;
+
+  if (!helper::File::ReadFile(
+      AppConfig::GetInstance().GetReportFilePath(), &html)) {
+    return false;
+  }
+
+  std::string_view rows;
+
+  if (!ReportParser::GetTableRows(html, &rows)) return false;
+
+  std::vector<uint32_t> dates;
+  std::vector<uint8_t> weeks;
+  std::vector<uint8_t> flags;
+  std::vector<int32_t> starts;
+  std::vector<int32_t> ends;
+  std::vector<int32_t> durations;
+  std::vector<int32_t> balances;
+  std::vector<uint32_t> tasks;
+
+  // Task dictionary, its 1st entry is the empty task
+  std::unordered_map<std::string, uint32_t> indexes_tasks{{"", kIndexNoTask}};
+  std::vector<uint32_t> offsets_dictionary{0, 0};
+
+  std::vector<uint32_t> offsets_comments{0};
+
+  // Strings of tasks, followed by those of comments
+  std::string heap;
+  std::string heap_comments;
+  std::string comment;
+
+  std::string_view cells[Report::Index_Balance + 1];
+  std::string_view row;
+
+  for (size_t offset = 0; ReportParser::GetNextRow(rows, &offset, &row);) {
+    if (ReportParser::GetCellsOfRow(row, cells, Report::Index_Balance + 1)
+        <= Report::Index_Duration) {
+      continue;
+    }
+
+    uint64_t timestamp = ReportMeta::Encode(cells[Report::Index_Meta]);
+
+    dates.push_back(ReportMeta::GetDate(timestamp));
+    weeks.push_back(static_cast<uint8_t>(ReportMeta::GetWeek(timestamp)));
+    flags.push_back(ReportMeta::IsOngoing(timestamp) ? kFlagOngoing : 0);
+
+    starts.push_back(GetMinutesFromCell(cells[Report::Index_Start]));
+    ends.push_back(GetMinutesFromCell(cells[Report::Index_End]));
+    durations.push_back(GetMinutesFromCell(cells[Report::Index_Duration]));
+    balances.push_back(GetMinutesFromCell(cells[Report::Index_Balance]));
+
+    auto [task, is_new] = indexes_tasks.try_emplace(
+        std::string(cells[Report::Index_Issue]),
+        static_cast<uint32_t>(offsets_dictionary.size() - 1));
+
+    if (is_new) {
+      heap.append(task->first);
+      offsets_dictionary.push_back(static_cast<uint32_t>(heap.size()));
+    }
+
+    tasks.push_back(task->second);
+
+    helper::Html::Decode(std::string(cells[Report::Index_Comment]), &comment);
+
+    heap_comments.append(comment);
+    offsets_comments.push_back(static_cast<uint32_t>(heap_comments.size()));
+  }
+
+  if (heap.size() + heap_comments.size()
+      > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  for (uint32_t &offset : offsets_comments) {
+    offset += static_cast<uint32_t>(heap.size());
+  }
+
+  heap.append(heap_comments);
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof header.magic);
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.amount_rows = static_cast<uint32_t>(dates.size());
+  header.amount_tasks = static_cast<uint32_t>(offsets_dictionary.size() - 1);
+
+  std::string content(sizeof header, '\0');
+
+  header.offset_dates = AppendColumn(dates, &content);
+  header.offset_weeks = AppendColumn(weeks, &content);
+  header.offset_flags = AppendColumn(flags, &content);
+  header.offset_starts = AppendColumn(starts, &content);
+  header.offset_ends = AppendColumn(ends, &content);
+  header.offset_durations = AppendColumn(durations, &content);
+  header.offset_balances = AppendColumn(balances, &content);
+  header.offset_tasks = AppendColumn(tasks, &content);
+  header.offset_dictionary = AppendColumn(offsets_dictionary, &content);
+  header.offset_comments = AppendColumn(offsets_comments, &content);
+
+  content.append((8 - content.size() % 8) % 8, '\0');
+
+  header.offset_heap = content.size();
+  header.size_heap = heap.size();
+
+  content.append(heap);
+
+  header.size_file = content.size();
+
+  std::memcpy(&content[0], &header, sizeof header);
+
+  return helper::File::ReplaceFile(path, content);
+}
+
+// Map given export into memory, check its header
+bool ReportColumnar::Map(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (-1 == fd) return false;
+
+  struct stat file_stat{};
+
+  if (-1 == fstat(fd, &file_stat)
+      || static_cast<size_t>(file_stat.st_size) < sizeof(Header)) {
+    close(fd);
+
+    return false;
+  }
+
+  size_ = static_cast<size_t>(file_stat.st_size);
+
+  void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  close(fd);
+
+  if (MAP_FAILED == data) return false;
+
+  data_ = static_cast<const char *>(data);
+
+  Header header{};
+  std::memcpy(&header, data_, sizeof header);
+
+  if (0 != std::memcmp(header.magic, kMagic, sizeof header.magic)
+      || kVersion != header.version
+      || kByteOrder != header.byte_order
+      || size_ != header.size_file) {
+    return false;
+  }
+
+  uint64_t amount_rows = header.amount_rows;
+
+  if (!IsColumnInFile(header.offset_dates, amount_rows, sizeof(uint32_t))
+      || !IsColumnInFile(header.offset_weeks, amount_rows, sizeof(uint8_t))
+      || !IsColumnInFile(header.offset_flags, amount_rows, sizeof(uint8_t))
+      || !IsColumnInFile(header.offset_starts, amount_rows, sizeof(int32_t))
+      || !IsColumnInFile(header.offset_ends, amount_rows, sizeof(int32_t))
+      || !IsColumnInFile(
+          header.offset_durations, amount_rows, sizeof(int32_t))
+      || !IsColumnInFile(
+          header.offset_balances, amount_rows, sizeof(int32_t))
+      || !IsColumnInFile(header.offset_tasks, amount_rows, sizeof(uint32_t))
+      || !IsColumnInFile(
+          header.offset_dictionary,
+          header.amount_tasks + uint64_t{1},
+          sizeof(uint32_t))
+      || !IsColumnInFile(
+          header.offset_comments, amount_rows + 1, sizeof(uint32_t))
+      || !IsColumnInFile(header.offset_heap, header.size_heap, 1)) {
+    return false;
+  }
+
+  // Point into the mapped file
+  columns_.amount_rows = header.amount_rows;
+  columns_.amount_tasks = header.amount_tasks;
+
+  columns_.dates =
+      reinterpret_cast<const uint32_t *>(data_ + header.offset_dates);
+  columns_.weeks =
+      reinterpret_cast<const uint8_t *>(data_ + header.offset_weeks);
+  columns_.flags =
+      reinterpret_cast<const uint8_t *>(data_ + header.offset_flags);
+  columns_.starts =
+      reinterpret_cast<const int32_t *>(data_ + header.offset_starts);
+  columns_.ends =
+      reinterpret_cast<const int32_t *>(data_ + header.offset_ends);
+  columns_.durations =
+      reinterpret_cast<const int32_t *>(data_ + header.offset_durations);
+  columns_.balances =
+      reinterpret_cast<const int32_t *>(data_ + header.offset_balances);
+  columns_.tasks =
+      reinterpret_cast<const uint32_t *>(data_ + header.offset_tasks);
+
+  offsets_dictionary_ =
+      reinterpret_cast<const uint32_t *>(data_ + header.offset_dictionary);
+  offsets_comments_ =
+      reinterpret_cast<const uint32_t *>(data_ + header.offset_comments);
+
+  heap_ = data_ + header.offset_heap;
+  size_heap_ = header.size_heap;
+
+  return true;
+}
+
+const ReportColumnar::Columns &ReportColumnar::GetColumns() const {
+  return columns_;
+}
+
+std::string_view ReportColumnar::GetTask(uint32_t index_task) const {
+  return index_task < columns_.amount_tasks
+         ? GetString(offsets_dictionary_, index_task)
+         : std::string_view();
+}
+
+std::string_view ReportColumnar::GetComment(uint32_t index_row) const {
+  return index_row < columns_.amount_rows
+         ? GetString(offsets_comments_, index_row)
+         : std::string_view();
+}
+
+// Get index of given task within the dictionary
+uint32_t ReportColumnar::FindTask(std::string_view task) const {
+  for (uint32_t index = 0; index < columns_.amount_tasks; ++index) {
+    if (GetTask(index) == task) return index;
+  }
+
+  return columns_.amount_tasks;
+}
+
+// Is given array within the mapped file, aligned?
+bool ReportColumnar::IsColumnInFile(
+    uint64_t offset,
+    uint64_t amount,
+    size_t size_item) const {
+  return 0 == offset % size_item
+      && offset <= size_
+      && amount <= (size_ - offset) / size_item;
+}
+
+// Get string of given index, ending where the next one of its kind starts
+std::string_view ReportColumnar::GetString(
+    const uint32_t *offsets,
+    uint32_t index) const {
+  uint32_t offset_end = offsets[index + 1];
+  uint32_t offset_begin = offsets[index];
+
+  if (offset_end > size_heap_ || offset_begin > offset_end) return {};
+
+  return {heap_ + offset_begin, offset_end - offset_begin};
+}
+
+int32_t ReportColumnar::GetMinutesFromCell(std::string_view content) {
+  return content.empty()
+         ? kEmpty
+         : helper::DateTime::GetSumMinutesFromTime(content);
+}
+
+}  // namespace tictac_track
@@ -0,0 +1,179 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_COLUMNAR_H_
+#define TTT_CLASS_REPORT_REPORT_COLUMNAR_H_
+
+#include <sys/mman.h>
+
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report.h>
+#include <ttt/class/report/report_meta.h>
+#include <ttt/class/report/report_parser.h>
+#include <ttt/class/report/report_stats.h>
+
+#include <ttt/helper/helper_date_time.h>
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_html.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tictac_track {
+
+// Columnar binary export of the timesheet, for analysis w/o parsing:
+// a header, followed by one fixed-width array per column, a dictionary of
+// tasks (referenced by index from the task column) and a heap of the
+// tasks' and (decoded) comments' strings. Columns are 8-byte aligned at
+// offsets given in the header, so loading is mapping the file into memory
+// and pointing into it. Numbers are stored in native byte order
+class ReportColumnar {
+ public:
+  // Value of empty start, end, duration and balance cells
+  static constexpr int32_t kEmpty = std::numeric_limits<int32_t>::min();
+
+  // Flags per row
+  static constexpr uint8_t kFlagOngoing = 1;
+
+  // Index of the (empty) task of entries w/o task
+  static constexpr uint32_t kIndexNoTask = 0;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    // 0x01020304 in the byte order the file was written in
+    uint32_t byte_order;
+
+    uint64_t size_file;
+    uint32_t amount_rows;
+    uint32_t amount_tasks;
+
+    // Offsets of the columns: dates as yyyymmdd (uint32_t), weeks (uint8_t,
+    // as in the meta column), flags (uint8_t), start, end, duration and
+    // balance in minutes (int32_t), tasks (uint32_t index into the
+    // dictionary), offsets of the tasks' and comments' strings within the
+    // heap (uint32_t, one more than tasks/rows: the end of the last one)
+    uint64_t offset_dates;
+    uint64_t offset_weeks;
+    uint64_t offset_flags;
+    uint64_t offset_starts;
+    uint64_t offset_ends;
+    uint64_t offset_durations;
+    uint64_t offset_balances;
+    uint64_t offset_tasks;
+    uint64_t offset_dictionary;
+    uint64_t offset_comments;
+    uint64_t offset_heap;
+    uint64_t size_heap;
+  };
+
+  // Columns of a mapped export
+  struct Columns {
+    uint32_t amount_rows = 0;
+    uint32_t amount_tasks = 0;
+
+    const uint32_t *dates = nullptr;
+    const uint8_t *weeks = nullptr;
+    const uint8_t *flags = nullptr;
+    const int32_t *starts = nullptr;
+    const int32_t *ends = nullptr;
+    const int32_t *durations = nullptr;
+    const int32_t *balances = nullptr;
+    const uint32_t *tasks = nullptr;
+  };
+
+  ReportColumnar() = default;
+  ~ReportColumnar();
+
+  ReportColumnar(const ReportColumnar &) = delete;
+  ReportColumnar &operator=(const ReportColumnar &) = delete;
+
+  // Export all rows of the timesheet to given file
+  static bool Export(const std::string &path);
+
+  // Map given export into memory, check its header
+  bool Map(const std::string &path);
+
+  [[nodiscard]] const Columns &GetColumns() const;
+
+  [[nodiscard]] std::string_view GetTask(uint32_t index_task) const;
+  [[nodiscard]] std::string_view GetComment(uint32_t index_row) const;
+
+  // Get index of given task within the dictionary,
+  // amount of tasks if not contained
+  [[nodiscard]] uint32_t FindTask(std::string_view task) const;
+
+ private:
+  static constexpr char kMagic[8] = {'T', 'T', 'T', 'C', 'O', 'L', 'S', '\0'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kByteOrder = 0x01020304;
+
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+
+  Columns columns_;
+
+  const uint32_t *offsets_dictionary_ = nullptr;
+  const uint32_t *offsets_comments_ = nullptr;
+  const char *heap_ = nullptr;
+  uint64_t size_heap_ = 0;
+
+  // Append given array to given content, 8-byte aligned, return its offset
+  template<typename T>
+  static uint64_t AppendColumn(const std::vector<T> &column,
+                               std::string *content) {
+    content->append((8 - content->size() % 8) % 8, '\0');
+
+    uint64_t offset = content->size();
+
+    content->append(
+        reinterpret_cast<const char *>(column.data()),
+        column.size() * sizeof(T));
+
+    return offset;
+  }
+
+  // Is given array within the mapped file, aligned?
+  [[nodiscard]] bool IsColumnInFile(
+      uint64_t offset,
+      uint64_t amount,
+      size_t size_item) const;
+
+  [[nodiscard]] std::string_view GetString(
+      const uint32_t *offsets,
+      uint32_t index) const;
+
+  static int32_t GetMinutesFromCell(std::string_view content);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_COLUMNAR_H_
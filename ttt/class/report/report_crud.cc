@@ -27,8 +27,10 @@
 #include <ttt/class/report/report_crud.h>
 #include <ttt/class/app/app.h>
 #include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report_lock.h>
 #include <ttt/class/report/report_parser.h>
 #include <ttt/class/report/report_recalculator.h>
+#include <ttt/class/report/report_tail.h>
 
 namespace tictac_track {
 
@@ -62,7 +64,7 @@ bool ReportCrud::EnsureReportExists(bool clear) {
   std::string report_file_path = config.GetReportFilePath();
 
   if (clear && helper::File::FileExists(report_file_path)) {
-    helper::File::Remove(report_file_path.c_str());
+    return InitReportFile(true);
   }
 
   if (helper::File::FileExists(report_file_path) || InitReportFile(false)) {
@@ -113,6 +115,19 @@ bool ReportCrud::UpsertEntry(
     EntryStatus status,
     const char *comment,
     const char *task_number) {
+  auto *tail = new ReportTail();
+
+  if (tail->LoadReportTail()
+      && (tail->IsAnyEntryOngoing() || !tail->IsAnyEntryOngoingBeforeTail())) {
+    bool result = UpsertEntryInTail(tail, status, comment, task_number);
+
+    delete tail;
+
+    return result;
+  }
+
+  delete tail;
+
   auto *parser = new ReportParser();
 
   if (!parser->LoadReportHtml()) {
@@ -128,7 +143,7 @@ bool ReportCrud::UpsertEntry(
   std::string html = parser->GetHtml();
 
   bool hasTrackedItems =
-      helper::String::GetSubStrCount(html.c_str(), "<tr") > 1;
+      helper::String::GetSubStrCount(html, "<tr") > 1;
 
   if (hasTrackedItems) {
     UpdateOngoingEntry(html, comment, true, time_stopped);
@@ -178,7 +193,72 @@ bool ReportCrud::UpsertEntry(
 
   html.replace(offset, 8, entry.append("\n</table>"));
 
-  return SaveReport(html) && ReportRecalculator::RecalculateAndUpdate();
+  if (!SaveReport(html)) return false;
+
+  // Fails only if there's nothing to recalculate: the started entry is the
+  // only one
+  ReportRecalculator::RecalculateAndUpdate();
+
+  return true;
+}
+
+// Insert/update timesheet entry within latest day only:
+// rows before are unchanged, their balance is continued
+bool ReportCrud::UpsertEntryInTail(
+    ReportTail *tail,
+    EntryStatus status,
+    const char *comment,
+    const char *task_number) {
+  std::string time_stopped = status == EntryStatus::Status_Started
+    ? "..."
+    : tictac_track::ReportDateTime::GetCurrentTime();
+
+  std::string html = tail->GetHtml();
+
+  UpdateOngoingEntry(html, comment, true, time_stopped);
+
+  tail->SetHtml(html);
+
+  if (status != EntryStatus::Status_Started) return tail->SaveReportTail();
+
+  // Add newly started entry
+  std::string date_current = report_date_time_->GetDateFormatted();
+
+  bool is_new_day = !tail->IsDateOfLatestEntry(date_current);
+
+  const std::string &task =
+      0 == std::strcmp(task_number, "0")
+      || 0 == std::strcmp(task_number, "-1")
+        ? ""
+        : task_number;
+
+  std::string entry = RenderEntryHtml(
+      is_new_day,
+      "s/" + ReportDateTime::GetTimestampForMeta(),
+      report_date_time_->GetCurrentWeekOfYear(),
+      report_date_time_->GetCurrentDayOfWeek(),
+      date_current,
+      tictac_track::ReportDateTime::GetCurrentTime(),
+      time_stopped,
+      task, comment);
+
+  auto offset = html.find("</table>", 0);
+
+  html.replace(offset, 8, entry.append("\n</table>"));
+
+  helper::String::ReplaceAll(html, "\n\n", "\n");
+
+  auto *recalculator = new ReportRecalculator(html);
+
+  recalculator->RecalculateRows(tail->GetBalanceInitial());
+
+  tail->SetHtml(recalculator->GetHtml());
+
+  delete recalculator;
+
+  tail->UpdateHeadTitle(date_current);
+
+  return tail->SaveReportTail();
 }
 
 // Insert stopped entry w/ given attributes, after entry w/ given index.
@@ -250,7 +330,11 @@ bool ReportCrud::InsertEntryAfter(
 
   html = html.replace(insertion_offset, 0, entry);
 
-  return SaveReport(html);
+  if (!SaveReport(html)) return false;
+
+  ReportRecalculator::RecalculateDayAndUpdate(row_index + 1);
+
+  return true;
 }
 
 // Update ongoing entry: append text to comment, set stop-time, set stopped
@@ -348,7 +432,7 @@ bool ReportCrud::AddFullDayEntry(
 
   if (html.empty()) return false;
 
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   std::string format_date = config.GetConfigValue("format_date");
 
@@ -397,7 +481,8 @@ bool ReportCrud::AddFullDayEntry(
   int required_per_day_minutes =
       helper::DateTime::GetSumMinutesFromTime(required_per_day);
 
-  int time_end_minutes = time_start_minutes + required_per_day_minutes;
+  int time_end_minutes =
+      (time_start_minutes + required_per_day_minutes) % (24 * 60);
 
   std::string time_end =
       helper::DateTime::GetHoursFormattedFromMinutes(time_end_minutes);
@@ -419,39 +504,59 @@ bool ReportCrud::AddFullDayEntry(
 
 // Add timesheet entry: stop currently ongoing entry
 bool ReportCrud::StopEntry(const char *comment) {
-  auto *parser = new ReportParser();
+  auto *parser = new ReportTail();
 
-  if (!parser->LoadReportHtml()) {
+  if (!parser->LoadReportTail() && !parser->LoadReportHtml()) {
     delete parser;
 
     return false;
   }
 
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
-  std::string do_safeguard_issue_number =
-      config.GetConfigValue("require_issue_no_when_stopping_entry");
+  bool do_safeguard_issue_number =
+      "1" == config.GetConfigValue("require_issue_no_when_stopping_entry")
+      && !parser->OngoingEntryContainsIssueNumber();
 
-  if ("1" == do_safeguard_issue_number
-      && !parser->OngoingEntryContainsIssueNumber()) {
-    SafeguardToAddIssueNumber();
-  }
+  bool do_safeguard_comment =
+      "1" == config.GetConfigValue("require_comment_when_stopping_entry")
+      && !parser->OngoingEntryContainsComment();
 
-  std::string do_safeguard_comment =
-      config.GetConfigValue("require_comment_when_stopping_entry");
+  delete parser;
 
-  if ("1" == do_safeguard_comment && !parser->OngoingEntryContainsComment()) {
-    parser->LoadReportHtml();
+  if (do_safeguard_issue_number || do_safeguard_comment) {
+    // Don't block other ttt processes while prompting
+    ReportLock::Suspend();
 
-    SafeguardToAddComment(parser->GetHtml());
-  }
+    int issue_number =
+        do_safeguard_issue_number ? SafeguardToAddIssueNumber() : 0;
 
-  delete parser;
+    std::string comment_required =
+        do_safeguard_comment ? SafeguardToAddComment() : "";
+
+    if (!ReportLock::Resume()) return false;
+
+    // The entry could have been stopped meanwhile
+    if (!IsAnyEntryOngoing()) {
+      return AppError::PrintError(
+          "Cannot stop: No entry is currently ongoing.");
+    }
+
+    if (0 != issue_number) UpdateIssueNumber(issue_number);
+
+    if (!comment_required.empty()) {
+      std::string html = GetReportHtml();
+
+      UpdateOngoingEntry(html, comment_required, false, "");
+
+      SaveReport(html);
+    }
+  }
 
   return UpsertEntry(EntryStatus::Status_Stopped, comment);
 }
 
-void ReportCrud::SafeguardToAddIssueNumber() {
+int ReportCrud::SafeguardToAddIssueNumber() {
   std::cout
     << "Please enter the related issue number of the entry to be stopped: ";
 
@@ -465,16 +570,17 @@ void ReportCrud::SafeguardToAddIssueNumber() {
     if (helper::String::IsNumeric(issue_number_str)
         && issue_number_str != "0") {
       issue_number = helper::String::ToInt(issue_number_str);
-      UpdateIssueNumber(issue_number);
     } else {
       std::cout
         << "Invalid issue number (must be numeric).\n"
            "Please enter issue number: ";
     }
   }
+
+  return issue_number;
 }
 
-void ReportCrud::SafeguardToAddComment(std::string html) {
+std::string ReportCrud::SafeguardToAddComment() {
   std::cout << "Please enter a comment for the entry to be stopped: ";
 
   std::string comment;
@@ -487,16 +593,14 @@ void ReportCrud::SafeguardToAddComment(std::string html) {
     std::cin.getline(input, sizeof(input));
     comment = input;
 
-    if (!comment.empty()) {
-      UpdateOngoingEntry(html, comment, false, "");
-
-      SaveReport(html);
-    } else if (i > 0) {
+    if (comment.empty() && i > 0) {
       // TODO(kay): use more elegant way to
       //  only after 1st getline-invocation execute validation/output
       std::cout << "Invalid comment (cannot be empty).\nPlease enter comment: ";
     }
   }
+
+  return comment;
 }
 
 // Append given text to comment of given or latest entry
@@ -508,6 +612,25 @@ bool ReportCrud::AppendComment(
     return false;
   }
 
+  std::string append = std::string(start_with_space ? " " : "").append(comment);
+
+  if (-1 == row_index) {
+    // Latest entry: rewrite only the tail
+    auto *tail = new ReportTail();
+
+    if (tail->LoadReportTail()) {
+      tail->AppendToColumn(-1, Report::ColumnIndexes::Index_Comment, append);
+
+      bool result = tail->SaveReportTail();
+
+      delete tail;
+
+      return result;
+    }
+
+    delete tail;
+  }
+
   auto *parser = new ReportParser();
 
   if (!parser->LoadReportHtml()) {
@@ -516,8 +639,6 @@ bool ReportCrud::AppendComment(
     return false;
   }
 
-  std::string append = std::string(start_with_space ? " " : "").append(comment);
-
   const std::string &html = parser->AppendToColumn(
       row_index,
       Report::ColumnIndexes::Index_Comment,
@@ -664,7 +785,7 @@ bool ReportCrud::Merge(int row_index) {
 }
 
 bool ReportCrud::IsMergeableAmountMinutes(int amount_minutes) {
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   std::string max_gap_str = config.GetConfigValue("max_mergeable_minutes_gap");
 
@@ -768,24 +889,50 @@ bool ReportCrud::Reset() {
 }
 
 bool ReportCrud::IsAnyEntryOngoing() {
+  auto *tail = new ReportTail();
+
+  if (tail->LoadReportTail()) {
+    bool is_ongoing =
+        tail->IsAnyEntryOngoing() || tail->IsAnyEntryOngoingBeforeTail();
+
+    delete tail;
+
+    return is_ongoing;
+  }
+
+  delete tail;
+
   std::string html = GetReportHtml();
 
   return !html.empty() && ReportParser::IsAnyEntryOngoing(html);
 }
 
 bool ReportCrud::CurrentDayHasTasks() {
+  std::string date_cell =
+      "<td>"
+      + report_date_time_->GetDateFormatted()
+      + "</td>";
+
+  auto *tail = new ReportTail();
+
+  if (tail->LoadReportTail()) {
+    // Entries are chronological: only the latest day can be the current one
+    bool has_tasks = tail->HtmlContains(date_cell);
+
+    delete tail;
+
+    return has_tasks;
+  }
+
+  delete tail;
+
   std::string html = GetReportHtml();
 
-  if (helper::String::GetSubStrCount(html.c_str(), "<tr") == 1) {
+  if (helper::String::GetSubStrCount(html, "<tr") == 1) {
     // There are no items tracked at all
     return false;
   }
 
-  std::string date_cell =
-      "<td>"
-      + report_date_time_->GetDateFormatted()
-      + "</td>";
-
   return std::string::npos != html.find(date_cell);
 }
 
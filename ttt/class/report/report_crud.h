@@ -36,6 +36,8 @@
 
 namespace tictac_track {
 
+class ReportTail;
+
 class ReportCrud : public ReportFile {
  public:
   // Get object instance. Initialize at 1st call
@@ -136,6 +138,13 @@ class ReportCrud : public ReportFile {
       const char *comment = "",
       const char *task_number = "");
 
+  // Insert/update timesheet entry within latest day of report file
+  bool UpsertEntryInTail(
+      ReportTail *tail,
+      EntryStatus status,
+      const char *comment,
+      const char *task_number);
+
   // Update ongoing entry: add to comment, set stop-time, set stopped
   static void UpdateOngoingEntry(
       std::string &html,
@@ -145,8 +154,9 @@ class ReportCrud : public ReportFile {
 
   static bool IsMergeableAmountMinutes(int amount_minutes);
 
-  static void SafeguardToAddIssueNumber();
-  static void SafeguardToAddComment(std::string html);
+  // Prompt for issue number / comment of the entry to be stopped
+  static int SafeguardToAddIssueNumber();
+  static std::string SafeguardToAddComment();
 };
 
 }  // namespace tictac_track
@@ -26,11 +26,12 @@
 
 #include <ttt/class/report/report_date_time.h>
 #include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report_meta.h>
 
 namespace tictac_track {
 
 ReportDateTime::ReportDateTime() {
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
 
   format_week_of_year_ = config.GetConfigValue("format_week_of_year");
   format_date_ = config.GetConfigValue("format_date");
@@ -118,16 +119,24 @@ std::string ReportDateTime::GetCurrentDayOfWeek(int offset_days) {
   return TranslateWeekday(weekdayNameEnglish.c_str());
 }
 
-// Get localize name of day of week, from given meta data
-std::string ReportDateTime::GetWeekdayByMeta(const std::string& meta) {
-  std::vector<std::string> meta_parts = helper::String::Explode(meta, '/');
-  int day_of_week = helper::DateTime::GetWeekdayIndexByDate(
-      helper::String::ToInt(meta_parts[1]),   // year
-      helper::String::ToInt(meta_parts[2]),   // month
-      helper::String::ToInt(meta_parts[4]));  // day
+// Get localized name of day of week, from given meta data
+const std::string &ReportDateTime::GetWeekdayByMeta(const std::string& meta) {
+  uint32_t date = PackMetaDate(meta);
+
+  auto iter = weekday_by_date_.find(date);
+
+  if (iter != weekday_by_date_.end()) return iter->second;
 
-  return TranslateWeekday(
-      helper::DateTime::GetWeekdayEnByIndex(day_of_week).c_str());
+  int day_of_week = helper::DateTime::GetWeekdayIndexByDate(
+      static_cast<int>(date / 10000),        // year
+      static_cast<int>(date / 100 % 100),    // month
+      static_cast<int>(date % 100));         // day
+
+  return weekday_by_date_.emplace(
+      date,
+      TranslateWeekday(
+          helper::DateTime::GetWeekdayEnByIndex(day_of_week).c_str()))
+      .first->second;
 }
 
 std::string ReportDateTime::GetCurrentTime() {
@@ -136,13 +145,10 @@ std::string ReportDateTime::GetCurrentTime() {
 }
 
 std::string ReportDateTime::GetDurationFormatted(
-    std::string time_started,
-    std::string time_stopped) {
-  int minutes_start =
-      helper::DateTime::GetSumMinutesFromTime(std::move(time_started), ":");
-
-  int minutes_end =
-      helper::DateTime::GetSumMinutesFromTime(std::move(time_stopped), ":");
+    std::string_view time_started,
+    std::string_view time_stopped) {
+  int minutes_start = helper::DateTime::GetSumMinutesFromTime(time_started);
+  int minutes_end = helper::DateTime::GetSumMinutesFromTime(time_stopped);
 
   int minutes_duration = minutes_end - minutes_start;
 
@@ -155,22 +161,17 @@ std::string ReportDateTime::GetDurationFormatted(
   return helper::DateTime::GetHoursFormattedFromMinutes(minutes_duration);
 }
 
+// Pack date of given meta data into yyyymmdd, e.g. 20190415
+uint32_t ReportDateTime::PackMetaDate(std::string_view meta) {
+  return ReportMeta::GetDate(ReportMeta::Encode(meta));
+}
+
 // Check whether meta-date1 is after meta-date2
 // Meta-date is passed built like: yyyy/mm/ww/dd
 bool ReportDateTime::IsMetaDateAfter(
-    const std::string& meta_date1,
-    const std::string& meta_date2) {
-  std::vector<std::string> meta_parts1 =
-      helper::String::Explode(meta_date1, '/');
-
-  std::vector<std::string> meta_parts2 =
-      helper::String::Explode(meta_date2, '/');
-
-  std::string date1_numeric = meta_parts1[0] + meta_parts1[1] + meta_parts1[3];
-  std::string date2_numeric = meta_parts2[0] + meta_parts2[1] + meta_parts2[3];
-
-  return
-    helper::String::ToInt(date1_numeric) > helper::String::ToInt(date2_numeric);
+    std::string_view meta_date1,
+    std::string_view meta_date2) {
+  return PackMetaDate(meta_date1) > PackMetaDate(meta_date2);
 }
 
 }  // namespace tictac_track
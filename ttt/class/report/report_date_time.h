@@ -27,8 +27,11 @@
 #ifndef TTT_CLASS_REPORT_REPORT_DATE_TIME_H_
 #define TTT_CLASS_REPORT_REPORT_DATE_TIME_H_
 
+#include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -50,20 +53,24 @@ class ReportDateTime {
 
   // Get day of week as string, localized into configured language
   std::string GetCurrentDayOfWeek(int offset_days = 0);
-  // Get localized name of day of week, from given meta data
-  std::string GetWeekdayByMeta(const std::string& meta);
+  // Get localized name of day of week, from given meta data.
+  // Names are cached per date, as recalculation asks for every row
+  const std::string &GetWeekdayByMeta(const std::string& meta);
 
   // Get current time of day as string
   static std::string GetCurrentTime();
 
   static std::string GetDurationFormatted(
-      std::string time_started,
-      std::string time_stopped);
+      std::string_view time_started,
+      std::string_view time_stopped);
+
+  // Pack date of given meta data (w/ or w/o status prefix) into yyyymmdd
+  static uint32_t PackMetaDate(std::string_view meta);
 
   // Check whether date1 is after date2
   static bool IsMetaDateAfter(
-      const std::string& meta_date1,
-      const std::string& meta_date2);
+      std::string_view meta_date1,
+      std::string_view meta_date2);
 
   // Translate e.g. "Monday" to "Montag", using configured locale language
   std::string TranslateWeekday(const char *weekday_name_en);
@@ -76,6 +83,9 @@ class ReportDateTime {
 
   std::string locale_key_;
 
+  // Localized names of day of week, by packed meta date
+  std::unordered_map<uint32_t, std::string> weekday_by_date_;
+
   const char *weekDayLabelsDe[7] =
       {"Montag", "Dienstag", "Mittwoch", "Donnerstag", "Freitag", "Samstag",
        "Sonntag"};
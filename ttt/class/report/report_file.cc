@@ -26,6 +26,7 @@
 
 #include <ttt/class/app/app.h>
 #include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report_backup.h>
 #include <ttt/class/report/report_file.h>
 #include <ttt/helper/helper_tui.h>
 
@@ -52,6 +53,17 @@ bool ReportFile::SaveReport(const std::string &html) {
   AppConfig &config = AppConfig::GetInstance();
   std::string report_file_path = config.GetReportFilePath();
 
+  std::string html_old;
+
+  if (ReportBackup::IsRecording()
+      && helper::File::ReadFile(report_file_path, &html_old)
+      && !ReportBackup::RecordChange(
+          0, html_old, html, ReportBackup::kMinLenSnapshot)) {
+    // Large change: keep the previous timesheet file for undo, w/o copying
+    return ReportBackup::RecordSnapshot(report_file_path)
+        && helper::File::ReplaceFile(report_file_path, html);
+  }
+
   std::ofstream outfile;
   outfile.open(report_file_path, std::ios_base::trunc);
   outfile << html;
@@ -65,13 +77,14 @@ bool ReportFile::InitReportFile(bool removeIfExists) {
   AppConfig &config = AppConfig::GetInstance();
   std::string report_file_path = config.GetReportFilePath();
 
+  std::string content = ReportParser::GetInitialReportHtml();
+
+  // Overwrite existing timesheet via SaveReport, to be recorded for undo
   if (helper::File::FileExists(report_file_path)
       && removeIfExists) {
-    std::remove(report_file_path.c_str());
+    return SaveReport(content);
   }
 
-  std::string content = ReportParser::GetInitialReportHtml();
-
   return helper::File::WriteToNewFile(report_file_path, content);
 }
 
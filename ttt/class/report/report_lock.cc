@@ -0,0 +1,116 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_lock.h>
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/app/app_error.h>
+#include <ttt/class/report/report_backup.h>
+#include <ttt/class/report/report_rollups.h>
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_string.h>
+
+#include <string>
+
+namespace tictac_track {
+
+int ReportLock::fd_ = -1;
+AppCommand::Commands ReportLock::command_ = AppCommand::Command_Invalid;
+bool ReportLock::is_suspended_ = false;
+
+ReportLock::LockModes ReportLock::GetLockModeByCommand(
+    AppCommand::Commands kCommand) {
+  if (ReportBackup::IsModifyingCommand(kCommand)) return LockMode_Exclusive;
+
+  switch (kCommand) {
+    case AppCommand::Command_Redo:
+    case AppCommand::Command_Undo:
+      return LockMode_Exclusive;
+    case AppCommand::Command_BrowseTaskUrl:
+    case AppCommand::Command_Csv:
+    case AppCommand::Command_CsvRecentTaskNumbers:
+    case AppCommand::Command_CsvDayTracks:
+    case AppCommand::Command_Export:
+    case AppCommand::Command_Stats:
+    case AppCommand::Command_View:
+    case AppCommand::Command_ViewWeek:
+    case AppCommand::Command_BrowseDayTasks:
+      return LockMode_Shared;
+    default:
+      return LockMode_None;
+  }
+}
+
+bool ReportLock::Acquire(AppCommand::Commands kCommand, bool print_error) {
+  LockModes mode = GetLockModeByCommand(kCommand);
+
+  if (LockMode_None == mode || -1 != fd_) return true;
+
+  command_ = kCommand;
+
+  AppConfig &config = AppConfig::GetInstance();
+
+  fd_ = helper::File::LockFile(
+      config.GetReportFilePath() + ".lock",
+      LockMode_Exclusive == mode,
+      helper::String::ToInt(config.GetConfigValue("lock_timeout"), 3000));
+
+  if (-1 != fd_) return true;
+
+  if (print_error) {
+    AppError::PrintError(
+        "Timesheet is locked by another ttt process, try again later.");
+  }
+
+  return false;
+}
+
+void ReportLock::Release() {
+  helper::File::UnlockFile(fd_);
+  fd_ = -1;
+}
+
+void ReportLock::Suspend() {
+  if (-1 == fd_) return;
+
+  Release();
+  is_suspended_ = true;
+}
+
+bool ReportLock::Resume() {
+  if (!is_suspended_) return true;
+
+  is_suspended_ = false;
+
+  if (!Acquire(command_)) return false;
+
+  if (ReportBackup::BackupReportBeforeProcessCommand(command_)) {
+    ReportRollups::Prepare();
+  }
+
+  return true;
+}
+
+}  // namespace tictac_track
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_LOCK_H_
+#define TTT_CLASS_REPORT_REPORT_LOCK_H_
+
+#include <ttt/class/app/app_commands.h>
+
+namespace tictac_track {
+
+// Cross-process lock of the timesheet, held while a command is processed.
+// Commands that only read the timesheet share the lock, modifying ones
+// (incl. undo and redo) hold it exclusively. The lock is set on
+// timesheet.html.lock, as the timesheet itself can be replaced by rename.
+// Waiting for the lock is limited via lock_timeout, 0 = fail immediately
+class ReportLock {
+ public:
+  enum LockModes {
+    LockMode_None,
+    LockMode_Shared,
+    LockMode_Exclusive
+  };
+
+  static LockModes GetLockModeByCommand(AppCommand::Commands kCommand);
+
+  // Lock timesheet as needed by given command. Returns false (and prints an
+  // error) if another process holds a conflicting lock beyond the timeout
+  static bool Acquire(
+      AppCommand::Commands kCommand,
+      bool print_error = true);
+
+  static void Release();
+
+  // Release the lock while waiting for user input, not to block other ttt
+  // processes meanwhile. Only before the command modified the timesheet
+  static void Suspend();
+
+  // Lock again after Suspend(). Recording of modifications restarts from
+  // the timesheet as it is now, other processes may have changed it
+  static bool Resume();
+
+ private:
+  static int fd_;
+
+  // Command the lock was acquired for, to be resumed after Suspend()
+  static AppCommand::Commands command_;
+  static bool is_suspended_;
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_LOCK_H_
@@ -0,0 +1,112 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_meta.h>
+#include <ttt/helper/helper_date_time.h>
+
+#include <cstring>
+
+namespace tictac_track {
+
+// Encode given meta text, built like: [s|p/]yyyy/mm/ww/dd
+uint64_t ReportMeta::Encode(std::string_view meta) {
+  bool is_ongoing = false;
+
+  if (meta.size() > 1 && '/' == meta[1]) {
+    is_ongoing = 's' == meta[0];
+    meta.remove_prefix(2);
+  }
+
+  uint64_t parts[4] = {};  // year, month, week, day
+
+  for (uint64_t &part : parts) {
+    size_t offset_slash = meta.find('/');
+
+    part = static_cast<uint64_t>(
+        helper::DateTime::ParseDigits(meta.substr(0, offset_slash)));
+
+    meta.remove_prefix(
+        std::string_view::npos == offset_slash
+          ? meta.size()
+          : offset_slash + 1);
+  }
+
+  uint64_t date = parts[0] * 10000 + parts[1] * 100 + parts[3];
+
+  return date << 8 | (parts[2] & 0x7F) << 1 | (is_ongoing ? 1 : 0);
+}
+
+uint32_t ReportMeta::GetDate(uint64_t timestamp) {
+  return static_cast<uint32_t>(timestamp >> 8);
+}
+
+int ReportMeta::GetWeek(uint64_t timestamp) {
+  return static_cast<int>(timestamp >> 1 & 0x7F);
+}
+
+bool ReportMeta::IsOngoing(uint64_t timestamp) {
+  return 1 == (timestamp & 1);
+}
+
+std::vector<uint64_t> ReportMeta::ExtractTimestamps(const std::string &html) {
+  const char *kMetaOpen = "<td class=\"meta\">";
+  size_t len_meta_open = strlen(kMetaOpen);
+
+  std::vector<uint64_t> timestamps;
+
+  size_t offset = html.find(kMetaOpen);
+
+  while (std::string::npos != offset) {
+    offset += len_meta_open;
+
+    size_t offset_end = html.find("</td>", offset);
+
+    if (std::string::npos == offset_end) break;
+
+    timestamps.push_back(
+        Encode(std::string_view(html).substr(offset, offset_end - offset)));
+
+    offset = html.find(kMetaOpen, offset_end);
+  }
+
+  return timestamps;
+}
+
+int ReportMeta::GetIndexBeforeDate(
+    const std::vector<uint64_t> &timestamps,
+    uint32_t date) {
+  int index = 0;
+
+  for (uint64_t timestamp : timestamps) {
+    if (GetDate(timestamp) > date) break;
+
+    ++index;
+  }
+
+  return index - 1;
+}
+
+}  // namespace tictac_track
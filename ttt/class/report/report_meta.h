@@ -0,0 +1,61 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_META_H_
+#define TTT_CLASS_REPORT_REPORT_META_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tictac_track {
+
+// Fixed-width, sortable encoding of the hidden meta column of entries.
+// The timesheet HTML keeps the meta text ("s/yyyy/mm/ww/dd") as compatible
+// rendering, comparisons and lookups work on the encoded timestamps.
+// Bits: date as yyyymmdd << 8 | week of year << 1 | is ongoing
+class ReportMeta {
+ public:
+  // Encode given meta text, w/ or w/o status prefix
+  static uint64_t Encode(std::string_view meta);
+
+  static uint32_t GetDate(uint64_t timestamp);
+  static int GetWeek(uint64_t timestamp);
+  static bool IsOngoing(uint64_t timestamp);
+
+  // Encode the meta of all entries of given timesheet HTML, in one pass
+  static std::vector<uint64_t> ExtractTimestamps(const std::string &html);
+
+  // Get index of the last entry before the 1st entry dated after given date
+  static int GetIndexBeforeDate(
+      const std::vector<uint64_t> &timestamps,
+      uint32_t date);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_META_H_
@@ -0,0 +1,523 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_pager.h>
+
+namespace tictac_track {
+
+// Page through the timesheet, starting at its end
+bool ReportPager::Page() {
+  if (!helper::Tui::IsStdoutTerminal() || !helper::Tui::EnterCbreakMode()) {
+    return PrintToCli(Scope_All, 0, -1);
+  }
+
+  // Lock only while reading, other ttt processes can modify meanwhile
+  ReportLock::Release();
+
+  if (!LoadIndex()) {
+    helper::Tui::RestoreTerminalMode();
+
+    return false;
+  }
+
+  // Frames are composed completely before being written
+  is_output_chunked_ = false;
+
+  index_top_ = GetAmountRows();
+
+  helper::Tui::EnterFullscreen();
+
+  do {
+    if (IsModified()) {
+      // Keep following the end, if viewed
+      bool is_at_end = index_top_ + amount_rows_visible_ >= GetAmountRows();
+
+      if (!LoadIndex()) message_ = "Cannot read timesheet";
+
+      if (is_at_end) index_top_ = GetAmountRows();
+    }
+
+    Render();
+  } while (HandleKey(ReadKeyDecoded()));
+
+  helper::Tui::LeaveFullscreen();
+  helper::Tui::RestoreTerminalMode();
+
+  return true;
+}
+
+// Index the rows of the timesheet file, while holding a shared lock
+bool ReportPager::LoadIndex() {
+  path_ = AppConfig::GetInstance().GetReportFilePath();
+
+  ReportLock::Acquire(AppCommand::Command_View, false);
+
+  int fd = open(path_.c_str(), O_RDONLY);
+
+  bool result = -1 != fd && LoadIndex(fd);
+
+  if (-1 != fd) close(fd);
+
+  ReportLock::Release();
+
+  return result;
+}
+
+bool ReportPager::LoadIndex(int fd) {
+  uint64_t size_file;
+
+  if (!helper::File::GetSizeAndTimeModified(
+      path_, &size_file, &time_modified_)) {
+    return false;
+  }
+
+  size_file_ = static_cast<size_t>(size_file);
+
+  if (!ReadHead(fd, size_file_, &head_)) return false;
+
+  size_t offset_head_end = head_.size();
+
+  // Table end is followed only by the closing body and html tags
+  std::string chunk;
+  size_t length_end = std::min(static_cast<size_t>(4096), size_file_);
+
+  if (!helper::File::ReadFileRange(
+      fd, size_file_ - length_end, length_end, &chunk)) {
+    return false;
+  }
+
+  size_t offset_table_end = chunk.rfind("</table>");
+
+  if (std::string::npos == offset_table_end) return false;
+
+  offset_table_end += size_file_ - length_end;
+
+  if (offset_table_end < offset_head_end) return false;
+
+  offsets_rows_.clear();
+
+  if (!ForEachRowOffset(
+      fd,
+      offset_head_end,
+      offset_table_end,
+      [&](size_t offset_row) { offsets_rows_.push_back(offset_row); })) {
+    return false;
+  }
+
+  offsets_rows_.push_back(offset_table_end);
+
+  return true;
+}
+
+// Has the timesheet file changed since it was indexed?
+bool ReportPager::IsModified() {
+  uint64_t size_file;
+  int64_t time_modified;
+
+  return !helper::File::GetSizeAndTimeModified(
+             path_, &size_file, &time_modified)
+      || size_file != size_file_
+      || time_modified != time_modified_;
+}
+
+int ReportPager::GetAmountRows() const {
+  return offsets_rows_.empty()
+         ? 0
+         : static_cast<int>(offsets_rows_.size()) - 1;
+}
+
+// Read HTML of given range of rows, while holding a shared lock
+bool ReportPager::ReadRows(int index_first, int amount, std::string *rows) {
+  rows->clear();
+
+  if (index_first < 0 || amount <= 0 || index_first + amount > GetAmountRows())
+    return false;
+
+  size_t offset = offsets_rows_[index_first];
+
+  ReportLock::Acquire(AppCommand::Command_View, false);
+
+  int fd = open(path_.c_str(), O_RDONLY);
+
+  bool result = -1 != fd
+      && helper::File::ReadFileRange(
+          fd, offset, offsets_rows_[index_first + amount] - offset, rows);
+
+  if (-1 != fd) close(fd);
+
+  ReportLock::Release();
+
+  return result;
+}
+
+bool ReportPager::ReadRowKeys(
+    int index_first,
+    int amount,
+    std::vector<RowKey> *keys) {
+  std::string rows;
+
+  if (!ReadRows(index_first, amount, &rows)) return false;
+
+  keys->clear();
+
+  size_t offset_first = offsets_rows_[index_first];
+
+  for (int index = index_first; index < index_first + amount; ++index) {
+    std::string_view row = std::string_view(rows).substr(
+        offsets_rows_[index] - offset_first,
+        offsets_rows_[index + 1] - offsets_rows_[index]);
+
+    keys->push_back({
+        ReportMeta::Encode(GetCellContent(row, Index_Meta)),
+        std::string(GetCellContent(row, Index_Issue))});
+  }
+
+  return true;
+}
+
+// Get index of the 1st row from given one on, in given direction,
+// that matches given predicate. Rows are read in chunks
+int ReportPager::FindRow(
+    int index_start,
+    int direction,
+    const std::function<bool(const RowKey &key)> &is_match) {
+  int amount_rows = GetAmountRows();
+  std::vector<RowKey> keys;
+
+  for (int index = index_start; index >= 0 && index < amount_rows;) {
+    int index_first = direction > 0
+        ? index
+        : std::max(0, index - kAmountRowsSearchChunk + 1);
+
+    int amount = direction > 0
+        ? std::min(kAmountRowsSearchChunk, amount_rows - index)
+        : index - index_first + 1;
+
+    if (!ReadRowKeys(index_first, amount, &keys)) return -1;
+
+    for (; index >= index_first && index < index_first + amount;
+         index += direction) {
+      if (is_match(keys[index - index_first])) return index;
+    }
+  }
+
+  return -1;
+}
+
+// Scroll to start of next day / week, or to start of the current one or
+// (if already there) the previous one
+void ReportPager::JumpToPeriod(bool forward, bool is_week) {
+  auto get_period = [is_week](const RowKey &key) {
+    uint32_t date = ReportMeta::GetDate(key.timestamp);
+
+    return is_week
+           ? date / 10000 * 100 + ReportMeta::GetWeek(key.timestamp)
+           : date;
+  };
+
+  int index_reference = forward ? index_top_ : index_top_ - 1;
+
+  std::vector<RowKey> keys;
+
+  if (index_reference < 0 || !ReadRowKeys(index_reference, 1, &keys)) return;
+
+  uint32_t period = get_period(keys[0]);
+
+  int index = FindRow(
+      index_reference,
+      forward ? 1 : -1,
+      [&](const RowKey &key) { return get_period(key) != period; });
+
+  if (forward) {
+    if (-1 == index) {
+      message_ = is_week ? "Latest week reached" : "Latest day reached";
+    } else {
+      index_top_ = index;
+    }
+
+    return;
+  }
+
+  // Row after the last one of the period before
+  index_top_ = index + 1;
+}
+
+// Scroll to next / previous entry of the task of the topmost row
+void ReportPager::JumpToTask(bool forward) {
+  std::vector<RowKey> keys;
+
+  if (!ReadRowKeys(index_top_, 1, &keys)) return;
+
+  std::string task = keys[0].task;
+
+  if (task.empty()) {
+    message_ = "Topmost entry has no task";
+
+    return;
+  }
+
+  int index = FindRow(
+      index_top_ + (forward ? 1 : -1),
+      forward ? 1 : -1,
+      [&task](const RowKey &key) { return key.task == task; });
+
+  if (-1 == index) {
+    message_ = "No further entries of task " + task;
+  } else {
+    index_top_ = index;
+  }
+}
+
+// Handle given key, returns false to quit
+bool ReportPager::HandleKey(int key) {
+  message_.clear();
+
+  switch (key) {
+    case -1:
+    case 'q':
+    case 'Q':
+      return false;
+    case 'j':
+    case '\n':
+      ++index_top_;
+      break;
+    case 'k':
+      --index_top_;
+      break;
+    case ' ':
+    case 'f':
+      index_top_ += amount_rows_visible_;
+      break;
+    case 'b':
+      index_top_ -= amount_rows_visible_;
+      break;
+    case 'g':
+      index_top_ = 0;
+      break;
+    case 'G':
+      index_top_ = GetAmountRows();
+      break;
+    case 'd':
+    case 'D':
+      JumpToPeriod('d' == key, false);
+      break;
+    case 'w':
+    case 'W':
+      JumpToPeriod('w' == key, true);
+      break;
+    case 't':
+    case 'T':
+      JumpToTask('t' == key);
+      break;
+    default:
+      break;
+  }
+
+  return true;
+}
+
+// Read key, translate escape sequences of cursor keys to their letters
+int ReportPager::ReadKeyDecoded() {
+  int key = helper::Tui::ReadKey();
+
+  if (27 != key) return key;
+
+  key = helper::Tui::ReadKey();
+
+  if ('[' != key && 'O' != key) return key;
+
+  key = helper::Tui::ReadKey();
+
+  switch (key) {
+    case 'A':
+      return 'k';
+    case 'B':
+      return 'j';
+    case 'H':
+      return 'g';
+    case 'F':
+      return 'G';
+    case '1':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+      // Home, End, Page up, Page down: followed by "~"
+      helper::Tui::ReadKey();
+
+      return '5' == key
+             ? 'b'
+             : '6' == key
+               ? ' '
+               : '1' == key || '7' == key ? 'g' : 'G';
+    default:
+      return key;
+  }
+}
+
+std::string_view ReportPager::GetCellContent(
+    std::string_view row,
+    int index_column) {
+  size_t offset = 0;
+
+  for (int index = 0; index <= index_column; ++index) {
+    offset = row.find("<td", offset);
+
+    if (std::string_view::npos == offset) return {};
+
+    offset += 3;
+  }
+
+  offset = row.find('>', offset);
+
+  if (std::string_view::npos == offset) return {};
+
+  ++offset;
+
+  size_t offset_end = row.find("</td>", offset);
+
+  return std::string_view::npos == offset_end
+         ? std::string_view{}
+         : row.substr(offset, offset_end - offset);
+}
+
+// Render the rows fitting into the terminal, and the status line
+void ReportPager::Render() {
+  int height = std::max(3, helper::System::GetAmountTerminalRows());
+  int amount_rows = GetAmountRows();
+  int amount_rows_shown = 0;
+
+  // Rows fit between header and status line, w/o separators between days
+  index_top_ = std::max(0, std::min(index_top_, amount_rows - (height - 2)));
+
+  while (true) {
+    int amount = std::min(height - 2, amount_rows - index_top_);
+
+    std::string rows;
+    if (amount > 0) ReadRows(index_top_, amount, &rows);
+
+    cells_.clear();
+    column_titles_.clear();
+    column_content_max_len_.clear();
+    id_first_row_rendered_ = 0;
+    render_scope_ = Scope_All;
+
+    if (!ExtractPartsFromReport(0, head_ + rows + "</table>")) return;
+
+    column_widths_.resize(column_content_max_len_.size(), 0);
+
+    for (size_t index = 0; index < column_widths_.size(); ++index) {
+      column_widths_[index] =
+          std::max(column_widths_[index], column_content_max_len_[index]);
+
+      column_content_max_len_[index] = column_widths_[index];
+    }
+
+    id_first_row_rendered_ = index_top_;
+    max_index_digits_ = helper::Numeric::GetAmountDigits(amount_rows);
+
+    output_.clear();
+    PrintHeader();
+    PrintRows(-1);
+
+    std::string body;
+    body.swap(output_);
+
+    // Compose frame from header and rows, as far as fitting
+    output_.append("\033[H");
+
+    size_t offset = !body.empty() && '\n' == body[0] ? 1 : 0;
+    amount_rows_shown = 0;
+
+    for (int amount_lines = 0;
+         amount_lines < height - 1 && offset < body.size();
+         ++amount_lines) {
+      size_t offset_end = body.find('\n', offset);
+
+      if (std::string::npos == offset_end) offset_end = body.size();
+
+      // Lines after the header containing a grid are rows, not separators
+      if (amount_lines > 0
+          && std::string::npos != body.find('|', offset)
+          && body.find('|', offset) < offset_end) {
+        ++amount_rows_shown;
+      }
+
+      output_.append(body, offset, offset_end - offset).append("\033[K\n");
+
+      offset = offset_end + 1;
+    }
+
+    output_.append("\033[J");
+
+    // End is viewed, but separators pushed rows out: scroll further
+    if (amount_rows_shown >= amount || index_top_ + amount < amount_rows) {
+      break;
+    }
+
+    index_top_ += amount - amount_rows_shown;
+  }
+
+  amount_rows_visible_ = std::max(1, amount_rows_shown);
+
+  std::string status = " ";
+
+  if (0 == amount_rows) {
+    status.append("No entries found. ");
+  } else {
+    status
+      .append(helper::Numeric::ToString(index_top_))
+      .append("-")
+      .append(helper::Numeric::ToString(index_top_ + amount_rows_shown - 1))
+      .append(" / ")
+      .append(helper::Numeric::ToString(amount_rows))
+      .append(" ");
+  }
+
+  if (!message_.empty()) status.append("| ").append(message_).append(" ");
+
+  status.append(
+      "| j/k: line  space/b: page  d/D: day  w/W: week  t/T: task  "
+      "g/G: start/end  q: quit ");
+
+  auto width = static_cast<size_t>(helper::System::GetMaxCharsPerTerminalRow());
+
+  if (width > 0 && status.size() > width) status.resize(width);
+
+  output_
+    .append("\033[")
+    .append(helper::Numeric::ToString(height))
+    .append(";1H")
+    .append(ansi_format_inverted_)
+    .append(status)
+    .append(ansi_format_reset_)
+    .append("\033[K");
+
+  FlushOutput();
+}
+
+}  // namespace tictac_track
@@ -0,0 +1,131 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_PAGER_H_
+#define TTT_CLASS_REPORT_REPORT_PAGER_H_
+
+#include <ttt/class/report/report_lock.h>
+#include <ttt/class/report/report_meta.h>
+#include <ttt/class/report/report_renderer_cli.h>
+
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_system.h>
+#include <ttt/helper/helper_tui.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tictac_track {
+
+// Interactive full-screen view of the timesheet (raw terminal mode + ANSI).
+// Only the rows within the terminal window are read from the file and
+// rendered, located via an index of the rows' file offsets. Column widths
+// grow w/ the widest content viewed so far.
+// The timesheet is locked only while reading from it, modifications by
+// other ttt processes are displayed at the next keystroke
+class ReportPager : public ReportRendererCli {
+ public:
+  // Page through the timesheet, starting at its end.
+  // Prints it instead, if stdin or stdout is no terminal
+  bool Page();
+
+ private:
+  // Amount of rows read at once when searching rows
+  static constexpr int kAmountRowsSearchChunk = 256;
+
+  // Meta timestamp and task of a row, to search rows by
+  struct RowKey {
+    uint64_t timestamp;
+    std::string task;
+  };
+
+  std::string path_;
+
+  // Timesheet HTML up to the end of the table head
+  std::string head_;
+
+  // File offsets of all rows, followed by the offset of the table end
+  std::vector<size_t> offsets_rows_;
+
+  // Size and modification time (in nanoseconds) of the indexed file
+  size_t size_file_ = 0;
+  int64_t time_modified_ = 0;
+
+  int index_top_ = 0;
+  int amount_rows_visible_ = 1;
+
+  // Maximum width per column among all rows viewed yet
+  std::vector<int> column_widths_;
+
+  std::string message_;
+
+  // Index the rows of the timesheet file. Returns false if unreadable
+  bool LoadIndex();
+  bool LoadIndex(int fd);
+
+  // Has the timesheet file changed since it was indexed?
+  bool IsModified();
+
+  [[nodiscard]] int GetAmountRows() const;
+
+  // Read HTML of given range of rows
+  bool ReadRows(int index_first, int amount, std::string *rows);
+
+  bool ReadRowKeys(int index_first, int amount, std::vector<RowKey> *keys);
+
+  // Get index of the 1st row from given one on, in given direction
+  // (1 / -1), that matches given predicate. -1 if there is none
+  int FindRow(
+      int index_start,
+      int direction,
+      const std::function<bool(const RowKey &key)> &is_match);
+
+  // Scroll to start of next (or current / previous) day or week
+  void JumpToPeriod(bool forward, bool is_week);
+
+  // Scroll to next / previous entry of the task of the topmost row
+  void JumpToTask(bool forward);
+
+  // Handle given key, returns false to quit
+  bool HandleKey(int key);
+
+  // Read key, translate escape sequences of cursor keys to their letters
+  static int ReadKeyDecoded();
+
+  static std::string_view GetCellContent(
+      std::string_view row,
+      int index_column);
+
+  // Render visible rows and status line
+  void Render();
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_PAGER_H_
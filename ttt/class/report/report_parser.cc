@@ -26,9 +26,12 @@
 
 #include <ttt/class/report/report_parser.h>
 #include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report_meta.h>
 
 namespace tictac_track {
 
+const char ReportParser::kTHeadStub[] = "<thead><tr></tr></thead>";
+
 ReportParser::ReportParser(std::string html): html_(std::move(html)) {
 }
 
@@ -39,7 +42,7 @@ bool ReportParser::LoadReportHtml() {
     return false;
   }
 
-  html_ = helper::String::ReplaceAll(html_.c_str(), "\n\n", "\n");
+  helper::String::ReplaceAll(html_, "\n\n", "\n");
 
   return true;
 }
@@ -50,12 +53,12 @@ std::string ReportParser::GetHtml() {
 
 void ReportParser::SetHtml(std::string html) {
   html_ = std::move(html);
+  last_index_ = -1;
 }
 
 // Get initial timesheet html
 std::string ReportParser::GetInitialReportHtml() {
   AppLocale locale = AppLocale::GetInstance();
-  AppConfig config = AppConfig::GetInstance();
 
   std::string title = locale.Translate("timesheet");
 
@@ -106,7 +109,7 @@ std::string ReportParser::GetStyle() {
 }
 
 std::string ReportParser::GetTHead() {
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
   AppLocale locale = AppLocale::GetInstance();
   locale.locale_key_ = config.GetConfigValue("locale").c_str();
 
@@ -236,13 +239,13 @@ std::string ReportParser::UpdateTitle() {
 }
 
 int ReportParser::GetAmountRows() {
-  return helper::String::GetSubStrCount(html_.c_str(), "<tr") - 1;
+  return helper::String::GetSubStrCount(html_, "<tr") - 1;
 }
 
 int ReportParser::GetLastIndex() {
   if (-1 == last_index_)
     // Do not count header. Subtract one more, as index is zero-based
-    last_index_ = helper::String::GetSubStrCount(html_.c_str(), "<tr") - 2;
+    last_index_ = helper::String::GetSubStrCount(html_, "<tr") - 2;
 
   return last_index_;
 }
@@ -303,27 +306,13 @@ int ReportParser::GetIndexBeforeMetaDate(const std::string& meta_date) {
     return false;
   }
 
-  int last_index = parser->GetLastIndex();
-
-  std::string meta_date_in_row;
-
-  for (int i = 0; i <= last_index; i++) {
-    // Check if meta_date_in_row is after meta_date
-    meta_date_in_row =
-        parser->GetColumnContent(
-            i,
-            Report::ColumnIndexes::Index_Meta).substr(2, std::string::npos);
-
-    if (ReportDateTime::IsMetaDateAfter(meta_date_in_row, meta_date)) {
-      delete parser;
-
-      return i - 1;
-    }
-  }
+  int index = ReportMeta::GetIndexBeforeDate(
+      ReportMeta::ExtractTimestamps(parser->html_),
+      ReportDateTime::PackMetaDate(meta_date));
 
   delete parser;
 
-  return last_index;
+  return index;
 }
 
 // Check whether given timesheet HTML contains
@@ -390,6 +379,75 @@ int ReportParser::GetOffsetTrOpenByIndex(
   return static_cast<int> (offset_tr);
 }
 
+// Get rows between the end of the table head and the end of the table
+bool ReportParser::GetTableRows(std::string_view html, std::string_view *rows) {
+  size_t offset_begin = html.find("</thead>");
+  size_t offset_end = html.rfind("</table>");
+
+  if (std::string_view::npos == offset_begin
+      || std::string_view::npos == offset_end
+      || offset_end < offset_begin) {
+    return false;
+  }
+
+  offset_begin += std::strlen("</thead>");
+
+  *rows = html.substr(offset_begin, offset_end - offset_begin);
+
+  return true;
+}
+
+// Get the 1st row from given offset on, up to the start of the next row
+bool ReportParser::GetNextRow(
+    std::string_view rows,
+    size_t *offset,
+    std::string_view *row) {
+  size_t offset_tr = rows.find("<tr", *offset);
+
+  if (std::string_view::npos == offset_tr) return false;
+
+  size_t offset_next = rows.find("<tr", offset_tr + 3);
+
+  *row = rows.substr(
+      offset_tr,
+      std::string_view::npos == offset_next
+      ? std::string_view::npos
+      : offset_next - offset_tr);
+
+  *offset = std::string_view::npos == offset_next ? rows.size() : offset_next;
+
+  return true;
+}
+
+// Get contents of up to given amount of cells of given row
+int ReportParser::GetCellsOfRow(
+    std::string_view row,
+    std::string_view *cells,
+    int amount_cells) {
+  size_t offset = 0;
+  int index_cell = 0;
+
+  for (; index_cell < amount_cells; ++index_cell) {
+    offset = row.find("<td", offset);
+    if (std::string_view::npos == offset) break;
+
+    offset = row.find('>', offset);
+    if (std::string_view::npos == offset) break;
+
+    size_t offset_cell_end = row.find("</td>", ++offset);
+    if (std::string_view::npos == offset_cell_end) break;
+
+    cells[index_cell] = row.substr(offset, offset_cell_end - offset);
+    offset = offset_cell_end;
+  }
+
+  for (int index = index_cell; index < amount_cells; ++index) {
+    cells[index] = std::string_view();
+  }
+
+  return index_cell;
+}
+
 // Get offset of <td> tag of start-time column
 // of currently ongoing entry in given html
 uint32_t ReportParser::GetOffsetTdStartInOngoingEntry() {
@@ -643,7 +701,7 @@ bool ReportParser::ReduceEntryTime(
   int duration = minutes_end - minutes_start;
 
   int minutes_subtrahend =
-      helper::DateTime::GetSumMinutesFromTime(std::move(subtrahend_hhmm));
+      helper::DateTime::GetSumMinutesFromTime(subtrahend_hhmm);
 
   if (duration < minutes_subtrahend) {
     std::string message = std::string("Entry duration is ")
@@ -39,6 +39,7 @@
 #include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -46,6 +47,10 @@ namespace tictac_track {
 
 class ReportParser : public Report {
  public:
+  // Stands in for the actual head when parsing an excerpt of rows,
+  // so row indexes start at the excerpt's 1st row
+  static const char kTHeadStub[];
+
   explicit ReportParser(std::string html = "");
 
   bool LoadReportHtml();
@@ -94,6 +99,24 @@ class ReportParser : public Report {
 
   static int GetOffsetTrOpenByIndex(const std::string &html, int index = -1);
 
+  // Get rows of the table of given timesheet HTML: between the end of the
+  // table head and the end of the table. False if there is no such table
+  static bool GetTableRows(std::string_view html, std::string_view *rows);
+
+  // Get the 1st row from given offset on within given rows, advance the
+  // offset to the row after it. False if there is none
+  static bool GetNextRow(
+      std::string_view rows,
+      size_t *offset,
+      std::string_view *row);
+
+  // Get contents of up to given amount of cells of given row, missing cells
+  // are set empty. Returns the amount of cells found
+  static int GetCellsOfRow(
+      std::string_view row,
+      std::string_view *cells,
+      int amount_cells);
+
   uint32_t GetOffsetTdStartInOngoingEntry();
 
   int GetMinutesBetweenEntryAndNext(int row_index);
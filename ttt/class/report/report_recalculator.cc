@@ -63,6 +63,162 @@ bool ReportRecalculator::Recalculate() {
   parser->UpdateTitle();
   parser->UpdateTableHeader();
 
+  html_ = parser->GetHtml();
+
+  delete parser;
+
+  RecalculateDays();
+
+  return ReportCrud::SaveReport(html_);
+}
+
+// Recalculate rows day by day: days are independent except for the balance.
+// Each day is recalculated w/ a balance starting from zero, the balance
+// before each day is the sum of the debits of all days before
+void ReportRecalculator::RecalculateDays() {
+  std::vector<size_t> offsets_days = GetOffsetsDays();
+
+  if (offsets_days.size() < 2) return;
+
+  size_t amount_days = offsets_days.size() - 1;
+
+  std::vector<std::string> days(amount_days);
+  std::vector<int> debits(amount_days);
+
+  auto recalculate_days = [&](size_t index_begin, size_t index_end) {
+    for (size_t index = index_begin; index < index_end; ++index) {
+      ReportRecalculator day(
+          kTHeadStub
+          + html_.substr(
+              offsets_days[index],
+              offsets_days[index + 1] - offsets_days[index])
+          + "\n</table>");
+
+      day.RecalculateRows();
+
+      days[index] = day.GetHtml();
+
+      debits[index] = helper::DateTime::GetSumMinutesFromTime(
+          day.GetColumnContent(
+              day.GetLastIndex(),
+              ColumnIndexes::Index_Balance));
+    }
+  };
+
+  helper::System::ForEachInRange(
+      amount_days, kMinDaysPerThread, recalculate_days);
+
+  std::vector<int> balances(amount_days);
+
+  int balance = 0;
+
+  for (size_t index = 0; index < amount_days; ++index) {
+    balance += debits[index];
+    balances[index] = balance;
+  }
+
+  auto update_balances = [&](size_t index_begin, size_t index_end) {
+    for (size_t index = index_begin; index < index_end; ++index) {
+      if (balances[index] != debits[index]) {
+        ReportParser::UpdateColumn(
+            days[index],
+            -1,
+            ColumnIndexes::Index_Balance,
+            helper::DateTime::GetHoursFormattedFromMinutes(balances[index]));
+      }
+    }
+  };
+
+  helper::System::ForEachInRange(
+      amount_days, kMinDaysPerThread, update_balances);
+
+  // Serialize days concurrently into the output buffer
+  size_t length_stub = std::strlen(kTHeadStub);
+  size_t length_rows_end = std::strlen("\n</table>");
+
+  std::vector<size_t> offsets_out(amount_days + 1);
+  offsets_out[0] = offsets_days[0];
+
+  for (size_t index = 0; index < amount_days; ++index) {
+    offsets_out[index + 1] =
+        offsets_out[index]
+        + days[index].size() - length_stub - length_rows_end;
+  }
+
+  std::string html(
+      offsets_out[amount_days] + html_.size() - offsets_days[amount_days],
+      '\0');
+
+  html_.copy(&html[0], offsets_days[0]);
+
+  auto copy_days = [&](size_t index_begin, size_t index_end) {
+    for (size_t index = index_begin; index < index_end; ++index) {
+      days[index].copy(
+          &html[offsets_out[index]],
+          offsets_out[index + 1] - offsets_out[index],
+          length_stub);
+    }
+  };
+
+  helper::System::ForEachInRange(
+      amount_days, kMinDaysPerThread, copy_days);
+
+  html_.copy(
+      &html[offsets_out[amount_days]],
+      std::string::npos,
+      offsets_days[amount_days]);
+
+  html_ = std::move(html);
+}
+
+// Get offsets of 1st row of each day, followed by offset of end of last day
+std::vector<size_t> ReportRecalculator::GetOffsetsDays() {
+  std::vector<size_t> offsets;
+
+  size_t offset_tr = html_.find("<tr", html_.find("</thead>"));
+  size_t offset_tr_last = offset_tr;
+
+  std::string date_previous;
+
+  while (std::string::npos != offset_tr) {
+    std::string date =
+        GetColumnContent(0, ColumnIndexes::Index_Date, offset_tr);
+
+    if (offsets.empty() || date != date_previous) {
+      offsets.push_back('\n' == html_[offset_tr - 1]
+                        ? offset_tr - 1
+                        : offset_tr);
+    }
+
+    date_previous = date;
+    offset_tr_last = offset_tr;
+    offset_tr = html_.find("<tr", offset_tr + 1);
+  }
+
+  if (offsets.empty()) return offsets;
+
+  size_t offset_end = html_.find("</tr>", offset_tr_last);
+
+  if (std::string::npos == offset_end) return {};
+
+  offsets.push_back(offset_end + 5);
+
+  return offsets;
+}
+
+// Update durations, day of week, sum task/day, sum day, balance of all rows,
+// continuing from given balance of the days before the 1st row
+void ReportRecalculator::RecalculateRows(int balance_initial) {
+  auto *parser = new ReportParser(html_);
+
+  int last_index = parser->GetLastIndex();
+
+  if (-1 == last_index) {
+    delete parser;
+
+    return;
+  }
+
   std::string
       balance_formatted,
       current_date,
@@ -72,7 +228,7 @@ bool ReportRecalculator::Recalculate() {
       previous_date;
 
   int sum_minutes_day = 0;
-  int balance = 0;
+  int balance = balance_initial;
 
   int minutes_per_day_should = helper::DateTime::GetSumMinutesFromTime(
       AppConfig::GetConfigValueStatic("debit_per_day"));
@@ -81,8 +237,6 @@ bool ReportRecalculator::Recalculate() {
 
   ClearTaskMaps();
 
-  html_ = parser->GetHtml();
-
   std::string weekday_name;
   std::string previous_meta;
 
@@ -220,10 +374,181 @@ bool ReportRecalculator::Recalculate() {
 
   delete parser;
   delete report_date_time;
+}
+
+// Recalculate only the day of given entry, shift balances of following days
+bool ReportRecalculator::RecalculateDayAndUpdate(int row_index) {
+  auto *recalculator = new ReportRecalculator();
+
+  bool result = recalculator->LoadReportHtml()
+      && (recalculator->RecalculateDay(row_index)
+          || recalculator->Recalculate());
+
+  delete recalculator;
+
+  return result;
+}
+
+// Recalculate day of given entry and shift following balances, save report.
+// Returns false w/o saving if balances around that day are not available
+bool ReportRecalculator::RecalculateDay(int row_index) {
+  UpdateTitle();
+
+  int offset_tr = GetOffsetTrOpenByIndex(html_, row_index);
+
+  if (-1 == offset_tr) return false;
+
+  std::string date =
+      GetColumnContent(row_index, ColumnIndexes::Index_Date, offset_tr);
+
+  // Find 1st and last row of that day
+  size_t offset_day_start = static_cast<size_t>(offset_tr);
+  size_t offset_tr_same_day = offset_day_start;
+
+  while (std::string::npos != offset_tr_same_day) {
+    offset_day_start = offset_tr_same_day;
+    offset_tr_same_day = GetOffsetTrSameDay(offset_day_start, date, false);
+  }
+
+  size_t offset_day_last = static_cast<size_t>(offset_tr);
+  offset_tr_same_day = offset_day_last;
+
+  while (std::string::npos != offset_tr_same_day) {
+    offset_day_last = offset_tr_same_day;
+    offset_tr_same_day = GetOffsetTrSameDay(offset_day_last, date, true);
+  }
+
+  size_t offset_day_end = html_.find("</tr>", offset_day_last);
+
+  if (std::string::npos == offset_day_end) return false;
+
+  offset_day_end += 5;
+
+  // Balance of the day before is continued
+  int balance_before = 0;
+
+  size_t offset_thead_end = html_.find("</thead>");
+  size_t offset_tr_before = html_.rfind("<tr", offset_day_start - 1);
+
+  if (std::string::npos != offset_tr_before
+      && offset_tr_before > offset_thead_end) {
+    std::string balance = GetColumnContent(
+        0,
+        ColumnIndexes::Index_Balance,
+        static_cast<int>(offset_tr_before));
+
+    if (balance.empty()) return false;
+
+    balance_before = helper::DateTime::GetSumMinutesFromTime(balance);
+  }
+
+  if ('\n' == html_[offset_day_start - 1]) --offset_day_start;
+
+  auto *day = new ReportRecalculator(
+      kTHeadStub
+      + html_.substr(offset_day_start, offset_day_end - offset_day_start)
+      + "\n</table>");
+
+  int last_index_day = day->GetLastIndex();
+
+  // Previous balance of the day: in its last row, if calculated before
+  int balance_old = balance_before;
+
+  for (int index = last_index_day; index >= 0; --index) {
+    std::string balance =
+        day->GetColumnContent(index, ColumnIndexes::Index_Balance);
+
+    if (!balance.empty()) {
+      balance_old = helper::DateTime::GetSumMinutesFromTime(balance);
+
+      break;
+    }
+  }
+
+  day->RecalculateRows(balance_before);
+
+  int balance_new = helper::DateTime::GetSumMinutesFromTime(
+      day->GetColumnContent(last_index_day, ColumnIndexes::Index_Balance));
+
+  std::string rows = day->GetHtml();
+
+  delete day;
+
+  size_t offset_rows = std::strlen(kTHeadStub);
+
+  std::string html;
+  html.reserve(html_.size() + 64);
+
+  html.append(html_, 0, offset_day_start)
+      .append(rows, offset_rows, rows.size() - offset_rows - 9);
+
+  AppendShiftedBalances(&html, offset_day_end, balance_new - balance_old);
+
+  html_ = html;
 
   return ReportCrud::SaveReport(html_);
 }
 
+// Get offset of "<tr" of next/previous row of same date, or npos
+size_t ReportRecalculator::GetOffsetTrSameDay(
+    size_t offset_tr,
+    const std::string &date,
+    bool forward) {
+  size_t offset = forward
+      ? html_.find("<tr", offset_tr + 1)
+      : html_.rfind("<tr", offset_tr - 1);
+
+  if (std::string::npos == offset
+      || (!forward && offset < html_.find("</thead>"))) {
+    return std::string::npos;
+  }
+
+  return date == GetColumnContent(
+      0,
+      ColumnIndexes::Index_Date,
+      static_cast<int>(offset))
+    ? offset
+    : std::string::npos;
+}
+
+// Shift all balances after given offset by given minutes, append to given
+void ReportRecalculator::AppendShiftedBalances(
+    std::string *html,
+    size_t offset,
+    int balance_delta) {
+  size_t offset_tr = 0 == balance_delta
+      ? std::string::npos
+      : html_.find("<tr", offset);
+
+  while (std::string::npos != offset_tr) {
+    size_t offset_td = GetColumnOffset(
+        "<td",
+        static_cast<uint32_t>(offset_tr),
+        ColumnIndexes::Index_Balance);
+
+    if (std::string::npos == offset_td) break;
+
+    size_t offset_content = html_.find('>', offset_td) + 1;
+    size_t offset_content_end = html_.find("</td>", offset_content);
+
+    if (offset_content_end > offset_content) {
+      int balance = helper::DateTime::GetSumMinutesFromTime(
+          html_.substr(offset_content, offset_content_end - offset_content));
+
+      html->append(html_, offset, offset_content - offset)
+          .append(
+              helper::DateTime::GetHoursFormattedFromMinutes(
+                  balance + balance_delta));
+
+      offset = offset_content_end;
+    }
+
+    offset_tr = html_.find("<tr", offset_content_end);
+  }
+
+  html->append(html_, offset, std::string::npos);
+}
+
 void ReportRecalculator::ClearTaskMaps() {
   task_in_day_last_index_.clear();
   task_in_day_duration_sum_.clear();
@@ -33,10 +33,12 @@
 #include <ttt/class/report/report_parser.h>
 
 #include <ttt/helper/helper_date_time.h>
+#include <ttt/helper/helper_system.h>
 
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace tictac_track {
 
@@ -49,6 +51,16 @@ class ReportRecalculator : public ReportParser {
   static bool RecalculateAndUpdate();
   bool Recalculate();
 
+  // Recalculate only the day of given (edited or inserted) entry and shift
+  // balances of all following days by the change of that day's balance, so
+  // sums and balances stay in sync w/o recalculating the whole timesheet.
+  // Falls back to full recalculation if the day cannot be recalculated alone
+  static bool RecalculateDayAndUpdate(int row_index);
+
+  // Recalculate rows only (no title, no saving),
+  // balance continuing from given amount of minutes
+  void RecalculateRows(int balance_initial = 0);
+
   void AddToTaskMaps(
       const std::string& task_number,
       int index_row,
@@ -62,6 +74,9 @@ class ReportRecalculator : public ReportParser {
   static std::string CalculateAndUpdateDuration(int row_index);
 
  private:
+  // Minimum amount of days per thread, when recalculating in parallel
+  static constexpr size_t kMinDaysPerThread = 64;
+
   // Map storing per one day: which entry row where tasks listed lastly?
   // this is where their sum is to be put
   std::map<std::string, int> task_in_day_last_index_;
@@ -73,6 +88,28 @@ class ReportRecalculator : public ReportParser {
   void UpdateTaskSumsFromMaps(std::string &html);
 
   void ClearTaskMaps();
+
+  // Recalculate rows day by day, on multiple threads for large timesheets
+  void RecalculateDays();
+
+  // Get offsets of 1st row of each day, followed by offset of end of last day
+  std::vector<size_t> GetOffsetsDays();
+
+  // Recalculate day of given entry and shift following balances, save report.
+  // Returns false w/o saving if balances around that day are not available
+  bool RecalculateDay(int row_index);
+
+  // Get offset of "<tr" of next/previous row of same date, or npos
+  size_t GetOffsetTrSameDay(
+      size_t offset_tr,
+      const std::string &date,
+      bool forward);
+
+  // Shift all balances after given offset by given minutes, append to given
+  void AppendShiftedBalances(
+      std::string *html,
+      size_t offset,
+      int balance_delta);
 };
 
 }  // namespace tictac_track
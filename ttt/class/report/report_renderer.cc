@@ -36,15 +36,8 @@ bool ReportRenderer::ExtractPartsFromReport(
   if (html.empty()) {
     AppConfig &config = AppConfig::GetInstance();
 
-    std::ifstream file(config.GetReportFilePath());
-
-    if (!file) {
-      return false;
-    }
-
-    html = helper::File::GetFileContents(file);
-
-    if (html.empty()) {
+    if (!helper::File::ReadFile(config.GetReportFilePath(), &html)
+        || html.empty()) {
       return false;
     }
   }
@@ -71,7 +64,7 @@ bool ReportRenderer::ExtractPartsFromReport(
   for (int index_column = 0; index_column < amount_columns_; index_column++) {
     // Store content-length as initial maximum length for the rel. column
     column_content_max_len_.push_back(
-        helper::String::GetUtf8Size(
+        helper::String::GetDisplayWidth(
             helper::Html::Decode(column_titles_[index_column])));
   }
 
@@ -82,91 +75,348 @@ bool ReportRenderer::ExtractPartsFromReport(
       cut_off_lhs_offset,
       table.size() - cut_off_lhs_offset - strlen("</table>"));
 
-  amount_rows_ = helper::String::GetSubStrCount(table.c_str(), "<tr");
+  amount_rows_ = helper::String::GetSubStrCount(table, "<tr");
+
+  InitScopeFilter(filter_offset);
 
-  std::vector<std::string> rows = ExtractRowsFromTable(table);
+  // Tokenize chunks of rows on worker threads, concatenate them in order
+  std::vector<size_t> offsets_chunks = GetOffsetsChunks(table);
 
-  std::string row;
+  size_t amount_chunks = offsets_chunks.size() - 1;
 
-  int contentLen;
+  std::vector<RowsChunk> chunks(amount_chunks);
 
-  InitScopeFilter(filter_offset);
+  auto extract_chunks = [&](size_t index_begin, size_t index_end) {
+    for (size_t index = index_begin; index < index_end; ++index) {
+      ExtractRowsChunk(
+          table.substr(
+              offsets_chunks[index],
+              offsets_chunks[index + 1] - offsets_chunks[index]),
+          &chunks[index]);
+    }
+  };
+
+  helper::System::ForEachInRange(amount_chunks, 1, extract_chunks);
+
+  for (auto &chunk : chunks) {
+    id_first_row_rendered_ += chunk.amount_rows_skipped;
+
+    cells_.insert(
+        cells_.end(),
+        std::make_move_iterator(chunk.cells.begin()),
+        std::make_move_iterator(chunk.cells.end()));
+
+    for (int index_column = 0; index_column < amount_columns_; ++index_column) {
+      if (chunk.column_content_max_len[index_column]
+          > column_content_max_len_[index_column]) {
+        column_content_max_len_[index_column] =
+            chunk.column_content_max_len[index_column];
+      }
+    }
+  }
+
+  return true;
+}
+
+// Extract parts of only the latest given amount of rows or days, read
+// backwards from the end of the timesheet file
+bool ReportRenderer::ExtractPartsFromReportTail(int amount, bool is_days) {
+  AppConfig &config = AppConfig::GetInstance();
+
+  int fd = open(config.GetReportFilePath().c_str(), O_RDONLY);
+  if (-1 == fd) return false;
+
+  struct stat file_stat{};
+
+  bool result = -1 != fstat(fd, &file_stat)
+      && ExtractPartsFromReportTail(
+          fd, static_cast<size_t>(file_stat.st_size), amount, is_days);
+
+  close(fd);
+
+  return result;
+}
+
+bool ReportRenderer::ExtractPartsFromReportTail(
+    int fd,
+    size_t size_file,
+    int amount,
+    bool is_days) {
+  std::string head;
+
+  if (!ReadHead(fd, size_file, &head)) return false;
+
+  size_t offset_head_end = head.size();
 
-  int amount_rows_filtered = 0;
+  // Read growing chunks backwards, until they contain enough rows / days
+  std::string rows;
+  size_t offset_rows = offset_head_end;
 
-  for (int indexRow = 0; indexRow < amount_rows_; indexRow++) {
-    row = rows[indexRow];
+  for (size_t length = kLenChunkTail; ; length *= 4) {
+    size_t offset = size_file - std::min(length, size_file - offset_head_end);
 
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "missing_default_case"
-    switch (render_scope_) {
-      case Scope_Day:
-        if (!helper::String::Contains(row, rows_filter_)) {
-          // Row does NOT contain the date to filter for: skip to next row
-          ++id_first_row_rendered_;
+    if (!helper::File::ReadFileRange(fd, offset, size_file - offset, &rows)) {
+      return false;
+    }
+
+    size_t offset_tail = FindOffsetTail(rows, amount, is_days);
+
+    if (std::string::npos != offset_tail) {
+      rows.erase(0, offset_tail);
+      offset_rows = offset + offset_tail;
 
-          continue;
-        }
+      break;
+    }
 
-        break;
-      case Scope_Week:
-        auto *parser = new ReportParser(html);
+    // All rows are within the tail
+    if (offset == offset_head_end) break;
+  }
 
-        std::string week_number =
-            parser->GetColumnContent(indexRow, ColumnIndexes::Index_Week);
+  size_t offset_table_end = rows.rfind("</table>");
 
-        delete parser;
+  if (std::string::npos == offset_table_end) return false;
 
-        std::string zero = "0";
+  rows.resize(offset_table_end);
 
-        if (1 == week_number.size() && 2 == rows_filter_.size()) {
-          week_number = zero.append(week_number);
-        }
+  render_scope_ = Scope_All;
 
-        if (0 != std::strcmp(week_number.c_str(), rows_filter_.c_str())) {
-          // Week-column of row does NOT contain the week to filter for:
-          // skip to next row
-          ++id_first_row_rendered_;
-          continue;
-        }
-        break;
+  if (!ExtractPartsFromReport(0, head.append(rows).append("</table>"))) {
+    return false;
+  }
+
+  id_first_row_rendered_ = CountRows(fd, offset_head_end, offset_rows);
+
+  return true;
+}
+
+// Get offset of the 1st of given amount of latest rows or days within
+// given end-part of the table, npos if it contains less
+size_t ReportRenderer::FindOffsetTail(
+    const std::string &rows,
+    int amount,
+    bool is_days) {
+  int amount_found = 0;
+  uint32_t date_last = 0;
+  size_t offset_day_start = std::string::npos;
+  size_t offset_tr = rows.size();
+
+  while (offset_tr > 0
+      && std::string::npos != (offset_tr = rows.rfind("<tr", offset_tr - 1))) {
+    if (!is_days) {
+      if (++amount_found == amount) return offset_tr;
+
+      continue;
     }
-#pragma clang diagnostic pop
 
-    ++amount_rows_filtered;
+    size_t offset_meta = rows.find("meta\">", offset_tr);
+
+    if (std::string::npos == offset_meta) return std::string::npos;
+
+    offset_meta += std::strlen("meta\">");
+
+    uint32_t date = ReportMeta::GetDate(ReportMeta::Encode(
+        std::string_view(rows).substr(
+            offset_meta,
+            rows.find('<', offset_meta) - offset_meta)));
+
+    if (date != date_last) {
+      // Reached the day before the requested ones
+      if (amount_found == amount) return offset_day_start;
+
+      ++amount_found;
+      date_last = date;
+    }
+
+    offset_day_start = offset_tr;
+  }
+
+  return std::string::npos;
+}
+
+// Read head of given timesheet file, up to the end of the table head
+bool ReportRenderer::ReadHead(int fd, size_t size_file, std::string *head) {
+  size_t offset_head_end = std::string::npos;
+
+  for (size_t length = kLenChunkTail; ; length *= 4) {
+    if (length > size_file) length = size_file;
+
+    if (!helper::File::ReadFileRange(fd, 0, length, head)) return false;
+
+    offset_head_end = head->find("</thead>");
+
+    if (std::string::npos != offset_head_end || length == size_file) break;
+  }
+
+  if (std::string::npos == offset_head_end) return false;
+
+  head->resize(offset_head_end + std::strlen("</thead>"));
+
+  return true;
+}
+
+// Invoke given callback w/ the file offset of each table row within given
+// range of given file, reading it in chunks
+bool ReportRenderer::ForEachRowOffset(
+    int fd,
+    size_t offset_start,
+    size_t offset_end,
+    const std::function<void(size_t offset_row)> &callback) {
+  std::string chunk;
+
+  for (size_t offset = offset_start; offset < offset_end;) {
+    size_t length = std::min(kLenChunkTail * 16, offset_end - offset);
+
+    // Overlap w/ the next chunk, for "<tr" split between both
+    size_t length_read = std::min(length + 2, offset_end - offset);
+
+    if (!helper::File::ReadFileRange(fd, offset, length_read, &chunk)) {
+      return false;
+    }
+
+    for (size_t offset_tr = chunk.find("<tr");
+         offset_tr < length;
+         offset_tr = chunk.find("<tr", offset_tr + 3)) {
+      callback(offset + offset_tr);
+    }
+
+    offset += length;
+  }
+
+  return true;
+}
+
+// Count table rows within given range of given file, w/o reading it at once
+int ReportRenderer::CountRows(int fd, size_t offset_start, size_t offset_end) {
+  int amount = 0;
+
+  ForEachRowOffset(fd, offset_start, offset_end, [&](size_t) { ++amount; });
+
+  return amount;
+}
+
+// Split given table rows into one chunk per worker thread,
+// at "<tr" boundaries. Returns chunk offsets, followed by end of rows
+std::vector<size_t> ReportRenderer::GetOffsetsChunks(const std::string &rows) {
+  size_t amount_chunks = std::min(
+      static_cast<size_t>(std::thread::hardware_concurrency()),
+      static_cast<size_t>(amount_rows_) / kMinRowsPerChunk);
+
+  std::vector<size_t> offsets{0};
+
+  for (size_t index = 1; index < amount_chunks; ++index) {
+    size_t offset = rows.find("<tr", index * rows.size() / amount_chunks);
+
+    if (std::string::npos == offset) break;
+
+    if (offset > offsets.back()) offsets.push_back(offset);
+  }
+
+  offsets.push_back(rows.size());
+
+  return offsets;
+}
+
+// Extract cells, maximum cell width per column and amount of rows
+// filtered out, from given chunk of table rows
+void ReportRenderer::ExtractRowsChunk(
+    std::string rows_html,
+    RowsChunk *chunk) {
+  int amount_rows = helper::String::GetSubStrCount(rows_html, "<tr");
+
+  std::vector<std::string> rows = ExtractRowsFromTable(std::move(rows_html));
+
+  chunk->column_content_max_len.assign(amount_columns_, 0);
+
+  std::string cell_decoded;
+
+  for (int index_row = 0; index_row < amount_rows; index_row++) {
+    std::string &row = rows[index_row];
+
+    if (!IsRowInScope(row)) {
+      // Skip to next row
+      ++chunk->amount_rows_skipped;
+
+      continue;
+    }
+
+    row = helper::String::ReplaceAll(row, {
+        {"<td>", ""},
+        {"<td class=\"meta\">", ""},
+        {"</td>", "|"}});
 
-    row = helper::String::ReplaceAll(row, "<td>", "");
-    row = helper::String::ReplaceAll(row, "<td class=\"meta\">", "");
-    row = helper::String::ReplaceAll(row, "</td>", "|");
     row = helper::String::ReplaceAll(row, "||", "| |");
 
     std::vector<std::string> columns = helper::String::Explode(row, '|');
 
     int amount_columns_current = columns.size();
 
-    if (columns.size() >= helper::Numeric::ToUnsignedInt(amount_columns_)) {
-      for (int indexColumn = 0; indexColumn < amount_columns_; indexColumn++) {
-        std::string cellContent = indexColumn < amount_columns_current
-            ? columns[indexColumn]
-            : "";
-
-        cells_.push_back(std::move(cellContent));
-        contentLen = indexColumn == Report::ColumnIndexes::Index_Comment
-                     ? helper::Numeric::ToUnsignedInt(
-                         helper::Html::Decode(columns[indexColumn]).size())
-                     : helper::Numeric::ToUnsignedInt(
-                         columns[indexColumn].size());
-
-        if (contentLen > column_content_max_len_[indexColumn]) {
-          // Cell content is longest string in this column:
-          // store as maximum length
-          column_content_max_len_[indexColumn] = contentLen;
-        }
+    if (columns.size() < helper::Numeric::ToUnsignedInt(amount_columns_)) {
+      continue;
+    }
+
+    for (int index_column = 0; index_column < amount_columns_; index_column++) {
+      int content_len =
+          GetCellWidth(index_column, columns[index_column], &cell_decoded);
+
+      if (content_len > chunk->column_content_max_len[index_column]) {
+        // Cell content is longest string in this column of the chunk
+        chunk->column_content_max_len[index_column] = content_len;
       }
+
+      chunk->cells.push_back(
+          index_column < amount_columns_current
+            ? std::move(columns[index_column])
+            : "");
     }
   }
+}
 
-  return true;
+// Check whether given row is within active day- / week- filter, if any
+bool ReportRenderer::IsRowInScope(std::string_view row) const {
+  switch (render_scope_) {
+    case Scope_Day:
+      // Row must contain the date to filter for
+      return std::string::npos != row.find(rows_filter_);
+    case Scope_Week: {
+      // Week-column of row must contain the week to filter for.
+      // The 1st plain "<td>" is the week, the meta-column has a class
+      size_t offset_week = row.find("<td>");
+
+      std::string week_number(
+          std::string::npos == offset_week
+          ? std::string_view()
+          : row.substr(
+              offset_week + 4,
+              row.find("</td>", offset_week) - offset_week - 4));
+
+      if (1 == week_number.size() && 2 == rows_filter_.size()) {
+        week_number.insert(0, "0");
+      }
+
+      return week_number == rows_filter_;
+    }
+    default:
+      return true;
+  }
+}
+
+// Get display width of given cell content (comments are HTML-decoded)
+int ReportRenderer::GetCellWidth(int index_column,
+                                 const std::string &content) {
+  return GetCellWidth(index_column, content, &cell_decoded_);
+}
+
+int ReportRenderer::GetCellWidth(
+    int index_column,
+    const std::string &content,
+    std::string *decoded) {
+  if (index_column != Report::ColumnIndexes::Index_Comment) {
+    return helper::String::GetDisplayWidth(content);
+  }
+
+  helper::Html::Decode(content, decoded);
+
+  return helper::String::GetDisplayWidth(*decoded);
 }
 
 std::string ReportRenderer::ExtractTheadFromTable(const std::string &table) {
@@ -183,7 +433,7 @@ std::string ReportRenderer::ExtractTheadFromTable(const std::string &table) {
     return "";
   }
 
-  amount_columns_ = helper::String::GetSubStrCount(tHead.c_str(), "<th");
+  amount_columns_ = helper::String::GetSubStrCount(tHead, "<th");
 
   return amount_columns_ == 0 ? "" : tHead;
 }
@@ -191,18 +441,20 @@ std::string ReportRenderer::ExtractTheadFromTable(const std::string &table) {
 // Reduce HTML to pipe-separated columns,
 // than split and assign to attribute: column_titles_
 void ReportRenderer::SetColumnTitlesExtractedFromTHead(std::string t_head) {
-  t_head = helper::String::ReplaceAll(t_head, "<th class=\"meta\">", "");
-  t_head = helper::String::ReplaceAll(t_head, "<th>", "");
-  t_head = helper::String::ReplaceAll(t_head, "</th>", "|");
+  t_head = helper::String::ReplaceAll(t_head, {
+      {"<th class=\"meta\">", ""},
+      {"<th>", ""},
+      {"</th>", "|"}});
 
   column_titles_ = helper::String::Explode(t_head, '|');
 }
 
 std::vector<std::string> ReportRenderer::ExtractRowsFromTable(
     std::string table) {
-  table = helper::String::ReplaceAll(table, "<tr>", "");
-  table = helper::String::ReplaceAll(table, "<tr class=\"new-day\">", "");
-  table = helper::String::ReplaceAll(table, "</tr>", "|");
+  table = helper::String::ReplaceAll(table, {
+      {"<tr>", ""},
+      {"<tr class=\"new-day\">", ""},
+      {"</tr>", "|"}});
 
   return helper::String::Explode(table, '|');
 }
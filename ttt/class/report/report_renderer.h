@@ -29,10 +29,18 @@
 
 #include <ttt/class/app/app_config.h>
 #include <ttt/class/report/report.h>
+#include <ttt/class/report/report_meta.h>
 #include <ttt/class/report/report_parser.h>
 
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_system.h>
+
+#include <algorithm>
 #include <cstring>
+#include <functional>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -52,6 +60,16 @@ class ReportRenderer : public Report {
   // Content of cells
   std::vector<std::string> cells_;
 
+  // Reusable buffer for HTML-decoding cell contents
+  std::string cell_decoded_;
+
+  // Get display width of given cell content (comments are HTML-decoded)
+  int GetCellWidth(int index_column, const std::string &content);
+  static int GetCellWidth(
+      int index_column,
+      const std::string &content,
+      std::string *decoded);
+
   int id_first_row_rendered_ = 0;
 
   // Extract from timesheet HTML:
@@ -59,7 +77,48 @@ class ReportRenderer : public Report {
   // rows amount, cells content
   bool ExtractPartsFromReport(int filter_offset, std::string html = "");
 
+  // Extract parts of only the latest given amount of rows or days, read
+  // backwards from the end of the timesheet file. IDs of the extracted rows
+  // continue the amount of rows before them
+  bool ExtractPartsFromReportTail(int amount, bool is_days);
+
+  // Check whether given row is within active day- / week- filter, if any
+  bool IsRowInScope(std::string_view row) const;
+
+  // Read head of given timesheet file, up to the end of the table head
+  static bool ReadHead(int fd, size_t size_file, std::string *head);
+
+  // Invoke given callback w/ the file offset of each table row within given
+  // range of given file, reading it in chunks
+  static bool ForEachRowOffset(
+      int fd,
+      size_t offset_start,
+      size_t offset_end,
+      const std::function<void(size_t offset_row)> &callback);
+
  private:
+  // Minimum amount of rows per chunk, when parsing on multiple threads
+  static constexpr size_t kMinRowsPerChunk = 4096;
+
+  // Initial length of parts read from the timesheet file, for tail views
+  static constexpr size_t kLenChunkTail = 16384;
+
+  // Cells, maximum cell width per column and amount of filtered-out rows
+  // of a chunk of table rows
+  struct RowsChunk {
+    std::vector<std::string> cells;
+    std::vector<int> column_content_max_len;
+    int amount_rows_skipped = 0;
+  };
+
+  // Split given table rows into one chunk per worker thread,
+  // at "<tr" boundaries. Returns chunk offsets, followed by end of rows
+  std::vector<size_t> GetOffsetsChunks(const std::string &rows);
+
+  // Extract cells, maximum cell width per column and amount of rows
+  // filtered out, from given chunk of table rows
+  void ExtractRowsChunk(std::string rows_html, RowsChunk *chunk);
+
   std::string ExtractTheadFromTable(const std::string &table);
 
   // Reduce HTML to pipe-separated columns,
@@ -67,6 +126,19 @@ class ReportRenderer : public Report {
   void SetColumnTitlesExtractedFromTHead(std::string t_head);
 
   static std::vector<std::string> ExtractRowsFromTable(std::string table);
+
+  bool ExtractPartsFromReportTail(
+      int fd,
+      size_t size_file,
+      int amount,
+      bool is_days);
+
+  // Get offset of the 1st of given amount of latest rows or days within
+  // given end-part of the table, npos if it contains less
+  static size_t FindOffsetTail(const std::string &rows, int amount, bool is_days);
+
+  // Count table rows within given range of given file
+  static int CountRows(int fd, size_t offset_start, size_t offset_end);
 };
 
 }  // namespace tictac_track
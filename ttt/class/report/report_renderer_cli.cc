@@ -32,9 +32,14 @@ namespace tictac_track {
 ReportRendererCli::ReportRendererCli() {
   InitAnsiTheme();
 
-  AppConfig config = AppConfig::GetInstance();
+  AppConfig &config = AppConfig::GetInstance();
+
+  int max_chars_per_row = helper::System::GetMaxCharsPerTerminalRow();
 
-  max_chars_per_comment_ = helper::System::GetMaxCharsPerTerminalRow() - 105;
+  // Width unknown (e.g. output is piped): do not truncate comments
+  max_chars_per_comment_ = 0 == max_chars_per_row
+                           ? std::numeric_limits<int>::max() - 1
+                           : max_chars_per_row - 105;
 
   if (max_chars_per_comment_ < 6) {
     // Ensure minimum length
@@ -63,7 +68,11 @@ bool ReportRendererCli::PrintToCli(
 
   PrintHeader();
 
-  if (0 != PrintRows(task_number, std::move(comment))) {
+  int amount_rows_printed = PrintRows(task_number, std::move(comment));
+
+  FlushOutput();
+
+  if (0 != amount_rows_printed) {
     return true;
   }
 
@@ -86,6 +95,30 @@ bool ReportRendererCli::PrintToCli(
   return false;
 }
 
+// Pretty-print only the latest given amount of rows or days
+bool ReportRendererCli::PrintTailToCli(
+    int amount,
+    bool is_days,
+    int task_number,
+    std::string comment) {
+  if (!ExtractPartsFromReportTail(amount, is_days)) return false;
+
+  max_index_digits_ =
+      helper::Numeric::GetAmountDigits(id_first_row_rendered_ + amount_rows_);
+
+  PrintHeader();
+
+  int amount_rows_printed = PrintRows(task_number, std::move(comment));
+
+  FlushOutput();
+
+  if (0 != amount_rows_printed) return true;
+
+  tictac_track::AppError::PrintError(" No entries found.\n");
+
+  return false;
+}
+
 bool ReportRendererCli::PrintBrowseDayTasks(int days_offset) {
   render_scope_ = RenderScopes::Scope_Day;
 
@@ -114,6 +147,10 @@ bool ReportRendererCli::PrintBrowseDayTasks(int days_offset) {
     return false;
   }
 
+  // Tasks are displayed from the HTML read now: unlock, not to block other
+  // ttt processes while waiting for key presses
+  ReportLock::Release();
+
   std::string date = report_date_time_instance_.GetDateFormatted(days_offset);
   std::vector<std::string> tasks = parser->GetIssueNumbersOfDay(date);
 
@@ -151,6 +188,8 @@ bool ReportRendererCli::PrintBrowseDayTasks(int days_offset) {
 
     PrintRows(task_number, "", false, false, false, false);
 
+    FlushOutput();
+
     tictac_track::ReportBrowser::BrowseTaskUrl(task_number);
 
     if (i < amount_tasks) {
@@ -208,12 +247,12 @@ void ReportRendererCli::PrintHeader(
     bool display_id,
     bool display_day_sum,
     bool display_saldo) {
-  std::cout << "\n" << theme_style_header_;
+  output_.append("\n").append(theme_style_header_);
 
   if (display_id && offset_id_column_ == 0) {
     PrintHeaderCellForId(true);
   } else {
-    std::cout << " ";
+    output_ += ' ';
   }
 
   int content_len;
@@ -226,11 +265,11 @@ void ReportRendererCli::PrintHeader(
             && (display_saldo
                 || index_column != Report::ColumnIndexes::Index_Balance)) {
       if (offset_id_column_ == 0 || index_column > 1) {
-        std::cout << "| ";
+        output_.append("| ");
       }
 
       std::string column_title = column_titles_[index_column];
-      std::cout << helper::Html::Decode(column_title) << " ";
+      output_.append(helper::Html::Decode(column_title)).append(" ");
 
       content_len =
           helper::String::GetAmountChars(helper::Html::Decode(column_title));
@@ -245,8 +284,9 @@ void ReportRendererCli::PrintHeader(
           column_len_diff = max_chars_per_comment_ - content_len;
         }
 
-        std::cout
-          << std::string(static_cast<u_int32_t>(column_len_diff), ' ');
+        if (column_len_diff > 0) {
+          output_.append(static_cast<u_int32_t>(column_len_diff), ' ');
+        }
       }
     }
 
@@ -255,21 +295,21 @@ void ReportRendererCli::PrintHeader(
     }
   }
 
-  std::cout << " " << helper::Tui::kAnsiFormatReset << "\n";
+  output_.append(" ").append(ansi_format_reset_).append("\n");
 }
 
-void ReportRendererCli::PrintHeaderCellForId(bool is_left_most) const {
+void ReportRendererCli::PrintHeaderCellForId(bool is_left_most) {
   if (!is_left_most) {
-    std::cout << "|";
+    output_ += '|';
   }
 
   auto amount_spaces = max_index_digits_ - 1;
 
   if (amount_spaces > 0) {
-    std::cout << std::string((amount_spaces), ' ');
+    output_.append(amount_spaces, ' ');
   }
 
-  std::cout << " ID ";
+  output_.append(" ID ");
 }
 
 // Output <tr>s using given filters, returns amount of rows printed
@@ -332,7 +372,7 @@ int ReportRendererCli::PrintRows(
       // New day: preceded by separation row
       if (index_cell > 0
           && previous_day != cells_[index_cell + 2]) {
-        std::cout << separation_row << "\n";
+        output_.append(separation_row).append("\n");
       }
 
       if (display_viewed_sum) {
@@ -362,10 +402,14 @@ int ReportRendererCli::PrintRows(
              previous_day);
 
     if (do_display) {
-      std::cout << " " << helper::Tui::kAnsiFormatReset << "\n";
+      output_.append(" ").append(ansi_format_reset_).append("\n");
 
       if (is_even) {
-        std::cout << helper::Tui::kAnsiFormatReset;
+        output_.append(ansi_format_reset_);
+      }
+
+      if (is_output_chunked_ && output_.size() >= kLenOutputChunk) {
+        FlushOutput();
       }
     }
   }
@@ -374,7 +418,7 @@ int ReportRendererCli::PrintRows(
     PrintDurationSums(task_number, sum_task_minutes);
   }
 
-  std::cout << helper::Tui::kAnsiFormatReset;
+  output_.append(ansi_format_reset_);
 
   return amount_rows_printed;
 }
@@ -477,31 +521,36 @@ void ReportRendererCli::PrintColumn(
     bool is_even) {
   if (index_column > 1) {
     // Skip column 0 (meta)
-    std::cout
-      << (is_even
-        ? theme_style_default_
-        : theme_style_grid_)
-      << "| " << helper::Tui::kAnsiFormatReset;
+    output_
+      .append(is_even ? theme_style_default_ : theme_style_grid_)
+      .append("| ")
+      .append(ansi_format_reset_);
   } else if (index_column == 1 && offset_id_column_ > 0) {
-    std::cout << " ";
+    output_ += ' ';
   }
 
   if (index_column > 0) {
-    std::string content = cells_[index_cell];
+    std::string content;
 
     if (index_column == Index_Comment) {
-      content = helper::Html::Decode(content);
+      helper::Html::Decode(cells_[index_cell], &content);
+    } else {
+      content = cells_[index_cell];
     }
 
     // TODO(kay): adjust max-length language specific
     // currently correct is: de: +1, en: +2
     helper::String::Ellipsis(content, max_chars_per_comment_ + 1);
 
-    std::cout << (is_even ? theme_style_default_ : "")
-              << (emphasize ? helper::Tui::kAnsiFormatInverted : "")
-              << content
-              << (emphasize ? helper::Tui::kAnsiFormatReset : "")
-              << " ";
+    if (is_even) output_.append(theme_style_default_);
+
+    if (emphasize) output_.append(ansi_format_inverted_);
+
+    output_.append(content);
+
+    if (emphasize) output_.append(ansi_format_reset_);
+
+    output_ += ' ';
   }
 
   PrintRhsCellSpaces(index_cell, index_column);
@@ -519,21 +568,21 @@ void ReportRendererCli::PrintDurationSums(
   std::string sum_duration_formatted =
       helper::DateTime::GetHoursFormattedFromMinutes(sum_task_minutes);
 
-  std::cout << "    ";
+  output_.append("    ");
 
   for (int index_column = 0; index_column < Index_Duration; index_column++) {
     PrintRhsCellSpaces(-1, index_column);
 
-    std::cout << " ";
+    output_ += ' ';
   }
 
-  std::cout << "  Σ";
+  output_.append("  Σ");
 
   if (-1 != task_number) {
-    std::cout << " " << task_number;
+    output_.append(" ").append(helper::Numeric::ToString(task_number));
   }
 
-  std::cout << ": " << sum_duration_formatted << "\n";
+  output_.append(": ").append(sum_duration_formatted).append("\n");
 }
 
 // Render separator row (printed between days)
@@ -554,15 +603,15 @@ std::string ReportRendererCli::RenderSeparationRow() {
     }
   }
 
-  return separation_row + helper::Tui::kAnsiFormatReset;
+  return separation_row + ansi_format_reset_;
 }
 
 void ReportRendererCli::PrintRowCellForId(bool is_left_most, int index_row) {
   if (!is_left_most) {
-    std::cout << '|';
+    output_ += '|';
   }
 
-  std::cout << ' ';
+  output_ += ' ';
 
   auto amount_digits_in_current_row_index =
       helper::Numeric::GetAmountDigits(index_row);
@@ -570,23 +619,28 @@ void ReportRendererCli::PrintRowCellForId(bool is_left_most, int index_row) {
   auto amount_spaces = max_index_digits_ - amount_digits_in_current_row_index;
 
   if (amount_spaces > 0) {
-    std::cout << std::string(amount_spaces, ' ');
+    output_.append(amount_spaces, ' ');
   }
 
-  std::cout << ' ' << index_row << ' ';
+  output_
+    .append(" ")
+    .append(helper::Numeric::ToString(index_row))
+    .append(" ");
 
   if (is_left_most) {
-    std::cout << "| ";
+    output_.append("| ");
   }
 
-  std::cout << theme_style_grid_;
+  output_.append(theme_style_grid_);
 }
 
 // Fill cell w/ spaces to keep width of cells in column identical
 void ReportRendererCli::PrintRhsCellSpaces(int index_cell, int index_column) {
-  int content_len = -1 == index_cell
-    ? 0
-    : helper::String::GetAmountChars(helper::Html::Decode(cells_[index_cell]));
+  int content_len = 0;
+
+  if (-1 != index_cell) {
+    content_len = GetCellWidth(index_column, cells_[index_cell]);
+  }
 
   int max_used_len = column_content_max_len_[index_column];
 
@@ -597,14 +651,24 @@ void ReportRendererCli::PrintRhsCellSpaces(int index_cell, int index_column) {
   if (content_len < max_used_len) {
     int column_len_diff = max_used_len - content_len;
 
-    std::cout
-      << std::string(static_cast<uint32_t>(column_len_diff), ' ');
+    output_.append(static_cast<uint32_t>(column_len_diff), ' ');
   }
 }
 
+// Write buffered output to stdout
+void ReportRendererCli::FlushOutput() {
+  helper::Tui::WriteToStdout(&output_);
+}
+
 // Initialize color/formatting theme style codes
 void ReportRendererCli::InitAnsiTheme() {
-  AppConfig config = AppConfig::GetInstance();
+  // Output is e.g. piped into a file or another program: w/o ANSI codes
+  if (!helper::Tui::IsStdoutTerminal()) return;
+
+  ansi_format_reset_ = helper::Tui::kAnsiFormatReset;
+  ansi_format_inverted_ = helper::Tui::kAnsiFormatInverted;
+
+  AppConfig &config = AppConfig::GetInstance();
 
   int theme_id = helper::String::ToInt(
       config.GetConfigValue("cli_theme").c_str(), 0);
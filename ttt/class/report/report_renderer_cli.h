@@ -30,12 +30,14 @@
 #include <ttt/class/report/report_renderer.h>
 #include <ttt/class/report/report_parser.h>
 #include <ttt/class/report/report_browser.h>
+#include <ttt/class/report/report_lock.h>
 #include <ttt/class//app/app_error.h>
 #include <ttt/helper/helper_tui.h>
 #include <ttt/helper/helper_file.h>
 
 #include <iostream>
 #include <cstring>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
@@ -62,6 +64,14 @@ class ReportRendererCli : public ReportRenderer {
       int task_number,
       std::string comment = "");
 
+  // Pretty-print only the latest given amount of rows or days,
+  // w/o parsing the rest of the timesheet
+  bool PrintTailToCli(
+      int amount,
+      bool is_days,
+      int task_number,
+      std::string comment = "");
+
   bool PrintBrowseDayTasks(int days_offset = 0);
 
  private:
@@ -70,10 +80,20 @@ class ReportRendererCli : public ReportRenderer {
   std::string GetActiveScopeName();
 
  protected:
-  // ANSI color/formatting codes for CLI output styling
+  // Length of buffered output, from which on it is written to stdout
+  static constexpr size_t kLenOutputChunk = 65536;
+
+  // Output composed by the Print* methods, written to stdout in chunks
+  std::string output_;
+  bool is_output_chunked_ = true;
+
+  // ANSI color/formatting codes for CLI output styling,
+  // all empty when stdout is no terminal
   std::string theme_style_header_;
   std::string theme_style_default_;
   std::string theme_style_grid_;
+  std::string ansi_format_reset_;
+  std::string ansi_format_inverted_;
 
   // Maximum mergeable amount of minutes between to entries
   // (lunch- or other long break)
@@ -94,7 +114,7 @@ class ReportRendererCli : public ReportRenderer {
       bool display_day_sum = true,
       bool display_saldo = true);
 
-  void PrintHeaderCellForId(bool is_left_most) const;
+  void PrintHeaderCellForId(bool is_left_most);
 
   // Output <tr>s, returns amount of rows printed
   int PrintRows(
@@ -123,6 +143,9 @@ class ReportRendererCli : public ReportRenderer {
   // Render separator row (printed between days)
   std::string RenderSeparationRow();
 
+  // Write buffered output to stdout
+  void FlushOutput();
+
   // Initialize color/formatting theme style codes
   void InitAnsiTheme();
 
@@ -0,0 +1,262 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_renderer_json.h>
+
+namespace tictac_track {
+
+ReportRendererJson::ReportRendererJson(std::ostream *out, Formats format)
+    : out_(out), format_(format) {
+}
+
+// Render entries of given scope, filtered by task (if not -1) and comment
+bool ReportRendererJson::Render(
+    RenderScopes scope,
+    int lookbehind_amount,
+    int task_number,
+    const std::string &comment) {
+  InitScopeFilter(scope, lookbehind_amount);
+  SetFilters(task_number, comment);
+
+  int fd = open(
+      AppConfig::GetInstance().GetReportFilePath().c_str(), O_RDONLY);
+
+  if (-1 == fd) return false;
+
+  if (Format_Json == format_) output_.append("[");
+
+  std::string_view cells[Index_Balance + 1];
+
+  // Rows yet to be rendered: parts of the file, w/ up to one incomplete row
+  std::string rows;
+  char chunk[kLenChunk];
+
+  bool is_in_table_body = false;
+  bool is_table_complete = false;
+  int id = 0;
+
+  for (ssize_t length;
+       !is_table_complete && (length = read(fd, chunk, sizeof chunk)) > 0;) {
+    rows.append(chunk, static_cast<size_t>(length));
+
+    size_t offset = 0;
+
+    if (!is_in_table_body) {
+      // The table head is small, it's within the 1st chunk(s)
+      offset = rows.find("</thead>");
+
+      if (std::string::npos == offset) continue;
+
+      offset += std::strlen("</thead>");
+      is_in_table_body = true;
+    }
+
+    for (;;) {
+      size_t offset_tr = rows.find("<tr", offset);
+
+      size_t offset_tr_end = std::string::npos == offset_tr
+                             ? std::string::npos
+                             : rows.find("</tr>", offset_tr);
+
+      if (std::string::npos == offset_tr_end) break;
+
+      offset = offset_tr_end + std::strlen("</tr>");
+
+      std::string_view row =
+          std::string_view(rows).substr(offset_tr, offset - offset_tr);
+
+      if (IsRowInScope(row)
+          && ReportParser::GetCellsOfRow(row, cells, Index_Balance + 1)
+              > Index_Duration) {
+        RenderRow(cells, id);
+      }
+
+      ++id;
+    }
+
+    is_table_complete = std::string::npos != rows.find("</table>", offset);
+
+    // Keep the incomplete row, or a possibly cut-off tag
+    size_t offset_keep = rows.find("<tr", offset);
+
+    if (std::string::npos == offset_keep) {
+      offset_keep = std::max(
+          offset, rows.size() - std::min(rows.size(), sizeof "</table>"));
+    }
+
+    rows.erase(0, offset_keep);
+
+    if (!Flush()) break;
+  }
+
+  close(fd);
+
+  return is_in_table_body && Flush(true);
+}
+
+// Render only the latest given amount of rows or days
+bool ReportRendererJson::RenderTail(
+    int amount,
+    bool is_days,
+    int task_number,
+    const std::string &comment) {
+  if (!ExtractPartsFromReportTail(amount, is_days)) return false;
+
+  SetFilters(task_number, comment);
+
+  if (Format_Json == format_) output_.append("[");
+
+  std::string_view cells[Index_Balance + 1];
+
+  auto amount_cells = static_cast<int>(cells_.size());
+
+  for (int index_row = 0;
+       index_row < amount_rows_
+           && (index_row + 1) * amount_columns_ <= amount_cells;
+       ++index_row) {
+    for (int index_column = 0; index_column <= Index_Balance; ++index_column) {
+      cells[index_column] = std::string_view();
+
+      if (index_column >= amount_columns_) continue;
+
+      const std::string &cell =
+          cells_[index_row * amount_columns_ + index_column];
+
+      // Empty cells are extracted as " "
+      if (" " != cell) cells[index_column] = cell;
+    }
+
+    RenderRow(cells, id_first_row_rendered_ + index_row);
+
+    if (!Flush()) return false;
+  }
+
+  return Flush(true);
+}
+
+void ReportRendererJson::SetFilters(
+    int task_number,
+    const std::string &comment) {
+  task_ = -1 == task_number ? "" : helper::Numeric::ToString(task_number);
+  comment_ = comment;
+}
+
+// Append objects of given row: its entry, and the sum and balance of its day
+void ReportRendererJson::RenderRow(const std::string_view *cells, int id) {
+  bool is_filtered = !task_.empty() || !comment_.empty();
+
+  if ((!task_.empty() && cells[Index_Issue] != task_)
+      || (!comment_.empty()
+          && std::string_view::npos == cells[Index_Comment].find(comment_))) {
+    return;
+  }
+
+  uint64_t timestamp = ReportMeta::Encode(cells[Index_Meta]);
+  uint32_t date = ReportMeta::GetDate(timestamp);
+
+  std::string date_iso = std::to_string(date / 10000)
+      .append("-").append(helper::Numeric::ToString(date / 100 % 100, 2))
+      .append("-").append(helper::Numeric::ToString(date % 100, 2));
+
+  BeginObject("entry");
+  AppendNumber("id", id);
+  AppendString("date", date_iso);
+  AppendNumber("week", ReportMeta::GetWeek(timestamp));
+  AppendString("day", cells[Index_Day]);
+  AppendString("start", cells[Index_Start]);
+  AppendString("end", cells[Index_End]);
+  AppendString("task", cells[Index_Issue]);
+
+  helper::Html::Decode(std::string(cells[Index_Comment]), &decoded_);
+  AppendString("comment", decoded_);
+
+  AppendString("duration", cells[Index_Duration]);
+  AppendString("sumTaskDay", cells[Index_SumTaskDay]);
+  output_.append(",\"ongoing\":")
+      .append(ReportMeta::IsOngoing(timestamp) ? "true" : "false")
+      .append("}");
+
+  // Sum and balance are set at the last entry of each day
+  if (is_filtered || cells[Index_SumDay].empty()) return;
+
+  BeginObject("day");
+  AppendString("date", date_iso);
+  AppendString("sum", cells[Index_SumDay]);
+  AppendString("balance", cells[Index_Balance]);
+  output_.append("}");
+}
+
+// Append separator before and opening of the next object
+void ReportRendererJson::BeginObject(const char *type) {
+  if (Format_Json == format_) {
+    output_.append(0 == amount_objects_ ? "\n" : ",\n");
+  } else if (0 != amount_objects_) {
+    output_.append("\n");
+  }
+
+  output_.append("{\"type\":\"").append(type).append("\"");
+
+  ++amount_objects_;
+}
+
+void ReportRendererJson::AppendNumber(const char *key, int64_t value) {
+  output_.append(",\"").append(key).append("\":").append(
+      std::to_string(value));
+}
+
+void ReportRendererJson::AppendString(const char *key, std::string_view value) {
+  output_.append(",\"").append(key).append("\":");
+
+  if (value.empty()) {
+    output_.append("null");
+
+    return;
+  }
+
+  output_.append("\"");
+  helper::String::JsonEncode(value, &output_);
+  output_.append("\"");
+}
+
+// Write buffered output, if longer than a chunk or if final (then closed)
+bool ReportRendererJson::Flush(bool is_final) {
+  if (is_final && Format_Json == format_) {
+    output_.append(0 == amount_objects_ ? "]\n" : "\n]\n");
+  } else if (is_final && 0 != amount_objects_) {
+    output_.append("\n");
+  }
+
+  if (!is_final && output_.size() < kLenChunk) return true;
+
+  out_->write(output_.data(), static_cast<std::streamsize>(output_.size()));
+  output_.clear();
+
+  if (is_final) out_->flush();
+
+  return out_->good();
+}
+
+}  // namespace tictac_track
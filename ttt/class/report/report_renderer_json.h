@@ -0,0 +1,114 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_RENDERER_JSON_H_
+#define TTT_CLASS_REPORT_REPORT_RENDERER_JSON_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report_meta.h>
+#include <ttt/class/report/report_renderer.h>
+
+#include <ttt/helper/helper_html.h>
+#include <ttt/helper/helper_numeric.h>
+#include <ttt/helper/helper_string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace tictac_track {
+
+// Render timesheet entries, day sums and balances as JSON (an array of
+// objects) or NDJSON (one object per line). Rows are read from the
+// timesheet file in chunks and written out while being parsed, w/o building
+// a document, so memory use does not grow w/ the size of the timesheet
+class ReportRendererJson : public ReportRenderer {
+ public:
+  enum Formats {
+    Format_Json,
+    Format_Ndjson
+  };
+
+  explicit ReportRendererJson(std::ostream *out, Formats format = Format_Json);
+
+  // Render entries of given scope, filtered by task (if not -1) and comment
+  bool Render(
+      RenderScopes scope,
+      int lookbehind_amount,
+      int task_number,
+      const std::string &comment = "");
+
+  // Render only the latest given amount of rows or days
+  bool RenderTail(
+      int amount,
+      bool is_days,
+      int task_number,
+      const std::string &comment = "");
+
+ private:
+  // Length of chunks read from the timesheet, and of buffered output
+  static constexpr size_t kLenChunk = 65536;
+
+  std::ostream *out_;
+  Formats format_;
+
+  std::string output_;
+  int amount_objects_ = 0;
+
+  std::string task_;
+  std::string comment_;
+
+  // Reusable buffer for HTML-decoding comments
+  std::string decoded_;
+
+  void SetFilters(int task_number, const std::string &comment);
+
+  // Append objects of given row: its entry, and the sum and balance of its
+  // day if it is the last of the day. Day sums are omitted when filtering
+  // by task or comment
+  void RenderRow(const std::string_view *cells, int id);
+
+  // Append separator before and opening of the next object
+  void BeginObject(const char *type);
+
+  // Append given field, its value as number or (JSON-encoded) string,
+  // or null if empty
+  void AppendNumber(const char *key, int64_t value);
+  void AppendString(const char *key, std::string_view value);
+
+  // Write buffered output, if longer than a chunk or if final (then closed)
+  bool Flush(bool is_final = false);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_RENDERER_JSON_H_
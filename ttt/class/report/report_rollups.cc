@@ -0,0 +1,594 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_rollups.h>
+
+namespace tictac_track {
+
+bool ReportRollups::is_prepared_ = false;
+std::vector<ReportRollups::Block> ReportRollups::blocks_;
+
+// Load blocks of the sidecar before the timesheet is modified
+void ReportRollups::Prepare() {
+  blocks_.clear();
+
+  std::string content;
+
+  if (!helper::File::ReadFile(GetPath(), &content)) return;
+
+  std::string_view lines(content);
+
+  if (!IsMatchingHeader(&lines)) return;
+
+  // Only the months' lines are parsed
+  for (size_t offset = 0; std::string_view::npos != offset;) {
+    if (0 != lines.compare(offset, 2, "m ")) break;
+
+    std::string_view fields = lines.substr(offset + 2);
+
+    Block block;
+
+    block.month = GetField(&fields);
+
+    if (!ParseNumber(GetField(&fields), &block.offset)) return;
+
+    block.week_first = GetField(&fields);
+    block.offset_sidecar = kLenHeader + offset;
+
+    blocks_.push_back(std::move(block));
+
+    offset = lines.find("\nm ", offset);
+
+    if (std::string_view::npos != offset) ++offset;
+  }
+
+  is_prepared_ = !blocks_.empty();
+}
+
+// Update sidecar after the timesheet was modified: aggregate again only the
+// months from the one before that of the 1st changed row on (weeks can span
+// months), all rows if unknown (e.g. snapshot)
+bool ReportRollups::Update() {
+  std::string path = GetPath();
+
+  if (!is_prepared_) {
+    // Not built yet or outdated: rebuilt by the next "stats"
+    if (helper::File::FileExists(path)) helper::File::Remove(path.c_str());
+
+    return false;
+  }
+
+  is_prepared_ = false;
+
+  std::string path_report = AppConfig::GetInstance().GetReportFilePath();
+
+  uint64_t size_file;
+  int64_t time_modified;
+
+  int fd = -1;
+
+  if (!helper::File::GetSizeAndTimeModified(
+          path_report, &size_file, &time_modified)
+      || -1 == (fd = open(path_report.c_str(), O_RDONLY))) {
+    helper::File::Remove(path.c_str());
+
+    return false;
+  }
+
+  std::string head;
+  size_t offset_rows = std::string::npos;
+
+  if (helper::File::ReadFileRange(
+      fd, 0, std::min(static_cast<size_t>(size_file), kMaxLenHead), &head)) {
+    offset_rows = head.find("</thead>");
+  }
+
+  size_t offset_changed = 0;
+
+  if (std::string::npos != offset_rows) {
+    offset_rows += std::strlen("</thead>");
+
+    // Changes of the head (title) don't move offsets after </thead>
+    offset_changed = ReportBackup::GetOffsetFirstChange(offset_rows);
+  }
+
+  // Outdated blocks are replaced from given offset on, if any
+  std::string content;
+  size_t offset_sidecar = std::string::npos;
+
+  bool is_updated = std::string::npos == offset_changed;
+
+  if (!is_updated && offset_changed >= offset_rows) {
+    // Latest month starting before the change
+    auto block = std::find_if(
+        blocks_.rbegin(),
+        blocks_.rend(),
+        [&](const Block &block) {
+          return block.offset < offset_changed - offset_rows;
+        });
+
+    if (block != blocks_.rend()) {
+      // Rows are aggregated again from the month before on, as weeks of the
+      // month can start in it
+      size_t offset = std::next(block) == blocks_.rend()
+                      ? block->offset
+                      : std::next(block)->offset;
+
+      Rollups rollups;
+
+      is_updated = AggregateFrom(
+          fd,
+          size_file,
+          offset_rows,
+          offset,
+          block->month,
+          block->week_first,
+          &rollups);
+
+      content = Serialize(rollups) + kMarkerEnd;
+      offset_sidecar = block->offset_sidecar;
+    }
+  }
+
+  close(fd);
+
+  if (!is_updated) {
+    Rollups rollups;
+
+    return Rebuild(&rollups);
+  }
+
+  // Replace outdated blocks, then the header
+  int fd_sidecar = open(path.c_str(), O_WRONLY);
+  if (-1 == fd_sidecar) return false;
+
+  bool result =
+      (std::string::npos == offset_sidecar
+          || (helper::File::WriteFileRange(fd_sidecar, offset_sidecar, content)
+              && 0 == ftruncate(
+                  fd_sidecar,
+                  static_cast<off_t>(offset_sidecar + content.size()))))
+      && helper::File::WriteFileRange(
+          fd_sidecar, 0, RenderHeader(size_file, time_modified));
+
+  close(fd_sidecar);
+
+  if (!result) helper::File::Remove(path.c_str());
+
+  return result;
+}
+
+// Get rollups, rebuild sidecar if missing or outdated
+bool ReportRollups::Get(Rollups *rollups) {
+  return Load(rollups) || Rebuild(rollups);
+}
+
+std::string ReportRollups::GetPath() {
+  return AppConfig::GetInstance().GetReportFilePath() + ".rollups";
+}
+
+// Check header of given sidecar content against the timesheet
+bool ReportRollups::IsMatchingHeader(std::string_view *content) {
+  if (content->size() < kLenHeader) return false;
+
+  std::string_view header = content->substr(0, kLenHeader - 1);
+
+  content->remove_prefix(kLenHeader);
+
+  int version = 0;
+
+  uint64_t size_file_header = 0;
+  int64_t time_modified_header = 0;
+
+  uint64_t size_file = 0;
+  int64_t time_modified = 0;
+
+  return "ttt-rollups" == GetField(&header)
+      && ParseNumber(GetField(&header), &version)
+      && kVersion == version
+      && ParseNumber(GetField(&header), &size_file_header)
+      && ParseNumber(header, &time_modified_header)
+      && helper::File::GetSizeAndTimeModified(
+          AppConfig::GetInstance().GetReportFilePath(),
+          &size_file,
+          &time_modified)
+      && size_file == size_file_header
+      && time_modified == time_modified_header;
+}
+
+std::string ReportRollups::RenderHeader(
+    uint64_t size_file,
+    int64_t time_modified) {
+  char header[kLenHeader + 1];
+
+  std::snprintf(
+      header,
+      sizeof header,
+      "ttt-rollups %d %020llu %020lld\n",
+      kVersion,
+      static_cast<unsigned long long>(size_file),  // NOLINT
+      static_cast<long long>(time_modified));      // NOLINT
+
+  return std::string(header, kLenHeader);
+}
+
+// Load sidecar, if it matches the timesheet
+bool ReportRollups::Load(Rollups *rollups) {
+  std::string content;
+
+  if (!helper::File::ReadFile(GetPath(), &content)) return false;
+
+  std::string_view lines(content);
+
+  if (!IsMatchingHeader(&lines)) return false;
+
+  *rollups = Rollups{};
+
+  Period *period = nullptr;
+
+  while (!lines.empty()) {
+    std::string_view fields = GetField(&lines, '\n');
+    std::string_view type = GetField(&fields);
+
+    if ("m" == type) {
+      period = &rollups->months[std::string(GetField(&fields))];
+
+      if (!ParseNumber(GetField(&fields), &period->offset)) return false;
+
+      period->week_first = GetField(&fields);
+    } else if ("w" == type) {
+      period = &rollups->weeks[std::string(GetField(&fields))];
+    } else if ("t" == type && nullptr != period) {
+      Aggregate aggregate;
+
+      // Task is the rest of the line
+      if (!ParseAggregate(&fields, &aggregate) || fields.empty()) {
+        return false;
+      }
+
+      period->tasks[std::string(fields)] = aggregate;
+
+      continue;
+    } else if ("e" == type) {
+      // Nothing may follow the end marker
+      return lines.empty();
+    } else if ("o" == type) {
+      Ongoing ongoing;
+
+      ongoing.month = GetField(&fields);
+      ongoing.week = GetField(&fields);
+      ongoing.start = GetField(&fields);
+      ongoing.task = fields;
+
+      if (ongoing.task.empty()) return false;
+
+      rollups->ongoing.push_back(std::move(ongoing));
+
+      continue;
+    } else {
+      return false;
+    }
+
+    if (!ParseAggregate(&fields, &period->total)) return false;
+  }
+
+  // Sidecar is cut off before its end marker
+  return false;
+}
+
+bool ReportRollups::Save(const Rollups &rollups) {
+  return helper::File::ReplaceFile(
+      GetPath(),
+      RenderHeader(rollups.size_file, rollups.time_modified)
+          + Serialize(rollups) + kMarkerEnd);
+}
+
+// Render given rollups as a block per month
+std::string ReportRollups::Serialize(const Rollups &rollups) {
+  std::string content;
+
+  auto week = rollups.weeks.begin();
+  auto ongoing = rollups.ongoing.begin();
+
+  for (auto month = rollups.months.begin();
+       month != rollups.months.end();
+       ++month) {
+    const Period &period = month->second;
+
+    content.append("m ").append(month->first)
+        .append(" ").append(std::to_string(period.offset))
+        .append(" ").append(period.week_first)
+        .append(" ").append(SerializeAggregate(period.total)).append("\n");
+
+    for (const auto &[task, aggregate] : period.tasks) {
+      content.append("t ").append(SerializeAggregate(aggregate))
+          .append(" ").append(task).append("\n");
+    }
+
+    // Weeks starting before the 1st row of the next month
+    auto month_next = std::next(month);
+
+    for (; week != rollups.weeks.end()
+             && (month_next == rollups.months.end()
+                 || week->first < month_next->second.week_first);
+         ++week) {
+      content.append("w ").append(week->first)
+          .append(" ").append(SerializeAggregate(week->second.total))
+          .append("\n");
+
+      for (const auto &[task, aggregate] : week->second.tasks) {
+        content.append("t ").append(SerializeAggregate(aggregate))
+            .append(" ").append(task).append("\n");
+      }
+    }
+
+    // Ongoing entries are collected in order of the rows
+    for (; ongoing != rollups.ongoing.end() && ongoing->month == month->first;
+         ++ongoing) {
+      content.append("o ").append(ongoing->month)
+          .append(" ").append(ongoing->week)
+          .append(" ").append(ongoing->start)
+          .append(" ").append(ongoing->task).append("\n");
+    }
+  }
+
+  return content;
+}
+
+// Aggregate all rows of the timesheet, save sidecar
+bool ReportRollups::Rebuild(Rollups *rollups) {
+  std::string path_report = AppConfig::GetInstance().GetReportFilePath();
+  std::string html;
+
+  *rollups = Rollups{};
+
+  if (!helper::File::GetSizeAndTimeModified(
+          path_report, &rollups->size_file, &rollups->time_modified)
+      || !helper::File::ReadFile(path_report, &html)
+      || !Build(html, rollups)) {
+    std::string path = GetPath();
+
+    if (helper::File::FileExists(path)) helper::File::Remove(path.c_str());
+
+    return false;
+  }
+
+  Save(*rollups);
+
+  return true;
+}
+
+// Aggregate all rows of given HTML, on multiple threads if large
+bool ReportRollups::Build(const std::string &html, Rollups *rollups) {
+  std::string_view rows;
+
+  if (!ReportParser::GetTableRows(html, &rows)) return false;
+
+  std::vector<size_t> offsets_chunks = ReportStats::GetOffsetsChunks(rows);
+
+  std::vector<Rollups> chunks(offsets_chunks.size() - 1);
+
+  helper::System::ForEachInRange(
+      chunks.size(),
+      1,
+      [&](size_t index_begin, size_t index_end) {
+        for (size_t index = index_begin; index < index_end; ++index) {
+          AggregateRows(
+              rows.substr(
+                  offsets_chunks[index],
+                  offsets_chunks[index + 1] - offsets_chunks[index]),
+              offsets_chunks[index],
+              "",
+              "",
+              &chunks[index]);
+        }
+      });
+
+  for (const Rollups &chunk : chunks) Merge(rollups, chunk);
+
+  return true;
+}
+
+// Aggregate rows from the one at given offset after </thead> on
+bool ReportRollups::AggregateFrom(
+    int fd,
+    size_t size_file,
+    size_t offset_rows,
+    size_t offset,
+    const std::string &month_min,
+    const std::string &week_min,
+    Rollups *rollups) {
+  if (offset_rows + offset > size_file) return false;
+
+  std::string rows;
+
+  if (!helper::File::ReadFileRange(
+      fd, offset_rows + offset, size_file - offset_rows - offset, &rows)) {
+    return false;
+  }
+
+  size_t offset_end = rows.rfind("</table>");
+
+  if (std::string::npos == offset_end) return false;
+
+  AggregateRows(
+      std::string_view(rows).substr(0, offset_end),
+      offset,
+      month_min,
+      week_min,
+      rollups);
+
+  return true;
+}
+
+// Aggregate given rows into months and weeks from given ones on
+void ReportRollups::AggregateRows(
+    std::string_view rows,
+    size_t offset_rows,
+    const std::string &month_min,
+    const std::string &week_min,
+    Rollups *rollups) {
+  std::string_view cells[Report::Index_Balance + 1];
+  std::string_view row;
+
+  for (size_t offset = 0; ReportParser::GetNextRow(rows, &offset, &row);) {
+    size_t offset_row =
+        offset_rows + static_cast<size_t>(row.data() - rows.data());
+
+    if (ReportParser::GetCellsOfRow(row, cells, Report::Index_Balance + 1)
+        <= Report::Index_Duration) {
+      continue;
+    }
+
+    uint64_t timestamp = ReportMeta::Encode(cells[Report::Index_Meta]);
+
+    std::string month =
+        ReportStats::GetGroupKey(ReportStats::Group_Month, timestamp, "");
+
+    std::string week =
+        ReportStats::GetGroupKey(ReportStats::Group_Week, timestamp, "");
+
+    bool is_in_month = month >= month_min;
+    bool is_in_week = week >= week_min;
+
+    if (!is_in_month && !is_in_week) continue;
+
+    std::string task = ReportStats::GetGroupKey(
+        ReportStats::Group_Task, timestamp, cells[Report::Index_Issue]);
+
+    Period *periods[2] = {
+        is_in_month ? &rollups->months[month] : nullptr,
+        is_in_week ? &rollups->weeks[week] : nullptr};
+
+    if (is_in_month && std::string::npos == periods[0]->offset) {
+      periods[0]->offset = offset_row;
+      periods[0]->week_first = week;
+    }
+
+    bool is_ongoing = ReportMeta::IsOngoing(timestamp)
+        && cells[Report::Index_Duration].empty()
+        && !cells[Report::Index_Start].empty();
+
+    if (is_ongoing && is_in_month) {
+      rollups->ongoing.push_back({
+          month, week, std::string(cells[Report::Index_Start]), task});
+    }
+
+    int minutes = ReportStats::GetMinutesOfEntry(
+        false,
+        cells[Report::Index_Start],
+        cells[Report::Index_Duration],
+        0);
+
+    for (Period *period : periods) {
+      if (nullptr == period) continue;
+
+      if (!is_ongoing) {
+        period->total.Add(minutes);
+        period->tasks[task].Add(minutes);
+      }
+
+      period->total.SetBalance(cells[Report::Index_Balance]);
+    }
+  }
+}
+
+// Merge given rollups of later rows
+void ReportRollups::Merge(Rollups *rollups, const Rollups &other) {
+  for (const auto &[key, period] : other.months) {
+    Period &merged = rollups->months[key];
+
+    if (std::string::npos == merged.offset) {
+      merged.offset = period.offset;
+      merged.week_first = period.week_first;
+    }
+
+    merged.total.Merge(period.total);
+
+    for (const auto &[task, aggregate] : period.tasks) {
+      merged.tasks[task].Merge(aggregate);
+    }
+  }
+
+  for (const auto &[key, period] : other.weeks) {
+    Period &merged = rollups->weeks[key];
+
+    merged.total.Merge(period.total);
+
+    for (const auto &[task, aggregate] : period.tasks) {
+      merged.tasks[task].Merge(aggregate);
+    }
+  }
+
+  rollups->ongoing.insert(
+      rollups->ongoing.end(), other.ongoing.begin(), other.ongoing.end());
+}
+
+std::string ReportRollups::SerializeAggregate(const Aggregate &aggregate) {
+  return std::to_string(aggregate.sum)
+      + " " + std::to_string(aggregate.amount)
+      + " " + std::to_string(aggregate.min)
+      + " " + std::to_string(aggregate.max)
+      + " " + (aggregate.has_balance
+               ? std::to_string(aggregate.balance)
+               : "-");
+}
+
+bool ReportRollups::ParseAggregate(
+    std::string_view *fields,
+    Aggregate *aggregate) {
+  if (!ParseNumber(GetField(fields), &aggregate->sum)
+      || !ParseNumber(GetField(fields), &aggregate->amount)
+      || !ParseNumber(GetField(fields), &aggregate->min)
+      || !ParseNumber(GetField(fields), &aggregate->max)) {
+    return false;
+  }
+
+  std::string_view balance = GetField(fields);
+
+  aggregate->has_balance = "-" != balance;
+
+  return !aggregate->has_balance
+      || ParseNumber(balance, &aggregate->balance);
+}
+
+// Get field of given content up to given separator, remove it from content
+std::string_view ReportRollups::GetField(
+    std::string_view *content,
+    char separator) {
+  size_t offset_separator = content->find(separator);
+
+  std::string_view field = content->substr(0, offset_separator);
+
+  content->remove_prefix(
+      std::string_view::npos == offset_separator
+      ? content->size()
+      : offset_separator + 1);
+
+  return field;
+}
+
+}  // namespace tictac_track
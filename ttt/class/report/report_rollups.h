@@ -0,0 +1,194 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_ROLLUPS_H_
+#define TTT_CLASS_REPORT_REPORT_ROLLUPS_H_
+
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report.h>
+#include <ttt/class/report/report_backup.h>
+#include <ttt/class/report/report_meta.h>
+#include <ttt/class/report/report_parser.h>
+#include <ttt/class/report/report_stats.h>
+
+#include <ttt/helper/helper_date_time.h>
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_system.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tictac_track {
+
+// Sidecar of the timesheet (timesheet.html.rollups), holding per-week and
+// per-month totals, per-task subtotals and the balance at the end of each
+// period. Durations of ongoing entries are kept apart, they are added when
+// read. Once built (by "stats"), every modification updates it within the
+// same command: only the months from the one before the 1st changed row on
+// are aggregated again. The sidecar is stored as chronological blocks, one
+// per month (incl. the weeks starting in it), so updating it truncates the
+// outdated blocks and appends new ones. A sidecar not matching the
+// timesheet's size and modification time is rebuilt from all rows
+class ReportRollups {
+ public:
+  using Aggregate = ReportStats::Aggregate;
+
+  struct Period {
+    Aggregate total;
+    std::map<std::string, Aggregate> tasks;
+
+    // Months only: offset of the 1st row (after </thead>) and its week
+    size_t offset = std::string::npos;
+    std::string week_first;
+  };
+
+  struct Ongoing {
+    std::string month;
+    std::string week;
+    std::string start;
+    std::string task;
+  };
+
+  struct Rollups {
+    // Size and modification time (ns) of the timesheet these are of
+    uint64_t size_file = 0;
+    int64_t time_modified = 0;
+
+    // Keyed "yyyy/mm" and "yyyy-Www", sorted chronologically
+    std::map<std::string, Period> months;
+    std::map<std::string, Period> weeks;
+
+    std::vector<Ongoing> ongoing;
+  };
+
+  // Load sidecar before the timesheet is modified
+  static void Prepare();
+
+  // Update sidecar after the timesheet was modified, from the changes being
+  // recorded. W/o a sidecar matching the timesheet before, it's removed
+  static bool Update();
+
+  // Get rollups, rebuild sidecar if missing or outdated
+  static bool Get(Rollups *rollups);
+
+ private:
+  static constexpr int kVersion = 2;
+
+  // Last line of the sidecar, a cut-off sidecar is rejected
+  static constexpr const char *kMarkerEnd = "e\n";
+
+  // Length of the header (w/ zero-padded numbers, to be rewritten in place)
+  static constexpr size_t kLenHeader = 56;
+
+  // Max. length of the head of the timesheet, up to </thead>
+  static constexpr size_t kMaxLenHead = 65536;
+
+  // Block of a month within the sidecar
+  struct Block {
+    std::string month;
+    size_t offset;
+    std::string week_first;
+    size_t offset_sidecar;
+  };
+
+  static bool is_prepared_;
+  static std::vector<Block> blocks_;
+
+  static std::string GetPath();
+
+  // Check header of given sidecar content against the timesheet,
+  // remove it from the content
+  static bool IsMatchingHeader(std::string_view *content);
+
+  static std::string RenderHeader(uint64_t size_file, int64_t time_modified);
+
+  // Load sidecar, if it matches the timesheet
+  static bool Load(Rollups *rollups);
+
+  static bool Save(const Rollups &rollups);
+
+  // Render given rollups as lines of space-separated fields: a block per
+  // month ("m", its tasks "t", weeks "w" w/ tasks, ongoing entries "o").
+  // W/o the end marker ("e"), which is appended when saving
+  static std::string Serialize(const Rollups &rollups);
+
+  // Aggregate all rows of the timesheet, save sidecar
+  static bool Rebuild(Rollups *rollups);
+
+  // Aggregate all rows of given HTML
+  static bool Build(const std::string &html, Rollups *rollups);
+
+  // Aggregate rows from the one at given offset after </thead> (at given
+  // offset of given file) on, into months and weeks from given ones on
+  static bool AggregateFrom(
+      int fd,
+      size_t size_file,
+      size_t offset_rows,
+      size_t offset,
+      const std::string &month_min,
+      const std::string &week_min,
+      Rollups *rollups);
+
+  // Aggregate given rows, at given offset after </thead>, into months and
+  // weeks from given ones on
+  static void AggregateRows(
+      std::string_view rows,
+      size_t offset_rows,
+      const std::string &month_min,
+      const std::string &week_min,
+      Rollups *rollups);
+
+  // Merge given rollups of later rows
+  static void Merge(Rollups *rollups, const Rollups &other);
+
+  static std::string SerializeAggregate(const Aggregate &aggregate);
+  static bool ParseAggregate(std::string_view *fields, Aggregate *aggregate);
+
+  // Get field of given content up to given separator, remove it from content
+  static std::string_view GetField(
+      std::string_view *content,
+      char separator = ' ');
+
+  // Parse given decimal, w/o allocating
+  template<typename T>
+  static bool ParseNumber(std::string_view digits, T *number) {
+    return !digits.empty()
+        && std::from_chars(digits.data(), digits.data() + digits.size(),
+                           *number).ptr == digits.data() + digits.size();
+  }
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_ROLLUPS_H_
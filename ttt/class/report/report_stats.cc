@@ -0,0 +1,718 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_stats.h>
+#include <ttt/class/report/report_columnar.h>
+#include <ttt/class/report/report_parser.h>
+#include <ttt/class/report/report_rollups.h>
+
+namespace tictac_track {
+
+void ReportStats::Aggregate::Add(int minutes) {
+  if (0 == amount || minutes < min) min = minutes;
+  if (0 == amount || minutes > max) max = minutes;
+
+  sum += minutes;
+  ++amount;
+}
+
+void ReportStats::Aggregate::SetBalance(std::string_view balance_cell) {
+  if (balance_cell.empty()) return;
+
+  balance = helper::DateTime::GetSumMinutesFromTime(balance_cell);
+  has_balance = true;
+}
+
+// Merge given aggregate of later entries
+void ReportStats::Aggregate::Merge(const Aggregate &other) {
+  if (other.has_balance) {
+    balance = other.balance;
+    has_balance = true;
+  }
+
+  if (0 == other.amount) return;
+
+  if (0 == amount || other.min < min) min = other.min;
+  if (0 == amount || other.max > max) max = other.max;
+
+  sum += other.sum;
+  amount += other.amount;
+}
+
+ReportStats::Groups ReportStats::ResolveGroupByName(const std::string &name) {
+  if (name == "task") return Group_Task;
+  if (name == "d" || name == "day") return Group_Day;
+  if (name == "w" || name == "week") return Group_Week;
+  if (name == "month") return Group_Month;
+  if (name == "year") return Group_Year;
+
+  return Group_Invalid;
+}
+
+// Parse period given as "yyyy", "yyyy/mm", "yyyy/mm/dd" or a range of those
+bool ReportStats::ParsePeriod(
+    const std::string &period,
+    uint32_t *date_first,
+    uint32_t *date_last) {
+  size_t offset_separator = period.find('-');
+
+  if (std::string::npos != offset_separator) {
+    uint32_t date_unused;
+
+    return ParsePeriod(
+            period.substr(0, offset_separator), date_first, &date_unused)
+        && ParsePeriod(
+            period.substr(offset_separator + 1), &date_unused, date_last)
+        && *date_first <= *date_last;
+  }
+
+  int parts[3] = {0, 0, 0};
+  int amount_parts = 0;
+
+  for (size_t offset = 0; offset <= period.size(); ++amount_parts) {
+    size_t offset_end = period.find('/', offset);
+
+    if (std::string::npos == offset_end) offset_end = period.size();
+
+    if (3 == amount_parts || offset_end == offset) return false;
+
+    std::string_view part =
+        std::string_view(period).substr(offset, offset_end - offset);
+
+    if (!std::all_of(part.begin(), part.end(), ::isdigit)) return false;
+
+    parts[amount_parts] = helper::DateTime::ParseDigits(part);
+
+    offset = offset_end + 1;
+  }
+
+  if (parts[0] < 1000 || parts[0] > 9999
+      || (amount_parts > 1 && (parts[1] < 1 || parts[1] > 12))
+      || (amount_parts > 2 && (parts[2] < 1 || parts[2] > 31))) {
+    return false;
+  }
+
+  auto year = static_cast<uint32_t>(parts[0]) * 10000;
+
+  *date_first = year
+      + (amount_parts > 1 ? parts[1] : 1) * 100
+      + (amount_parts > 2 ? parts[2] : 1);
+
+  *date_last = year
+      + (amount_parts > 1 ? parts[1] : 12) * 100
+      + (amount_parts > 2 ? parts[2] : 31);
+
+  return true;
+}
+
+// Aggregate entries within given period, of given task only (if not -1)
+bool ReportStats::Print(
+    Groups group,
+    const std::string &period,
+    int task_number,
+    const std::string &path_columnar) {
+  uint32_t date_first = 0;
+  uint32_t date_last = 0;
+
+  if (!period.empty() && !ParsePeriod(period, &date_first, &date_last)) {
+    return AppError::PrintError(
+        "Invalid period. Examples: p=2020, p=2020/03, p=2020/01-2020/03");
+  }
+
+  std::string task = -1 == task_number
+                     ? ""
+                     : helper::Numeric::ToString(task_number);
+
+  int minutes_now = helper::DateTime::GetSumMinutesFromTime();
+
+  Aggregates aggregates;
+
+  // Rollups cover whole weeks and months: periods of days, and weeks
+  // spanning the bounds of a given period, are aggregated from the rows
+  bool is_period_of_months = period.empty()
+      || (1 == date_first % 100 && 31 == date_last % 100
+          && Group_Week != group);
+
+  bool is_aggregated;
+
+  if (!path_columnar.empty()) {
+    is_aggregated = AggregateColumnar(
+        group,
+        date_first,
+        date_last,
+        task,
+        minutes_now,
+        path_columnar,
+        &aggregates);
+  } else {
+    is_aggregated = Group_Day != group && is_period_of_months
+        ? AggregateRollups(
+            group, date_first, date_last, task, minutes_now, &aggregates)
+        : AggregateTimesheet(
+            group, date_first, date_last, task, minutes_now, &aggregates);
+  }
+
+  if (!is_aggregated) return false;
+
+  if (aggregates.empty()) return AppError::PrintError("No entries found.");
+
+  std::vector<std::pair<std::string, Aggregate>> groups(
+      aggregates.begin(), aggregates.end());
+
+  std::sort(
+      groups.begin(),
+      groups.end(),
+      [](const auto &lhs, const auto &rhs) {
+        return IsKeyBefore(lhs.first, rhs.first);
+      });
+
+  Aggregate total;
+
+  for (const auto &entry : groups) total.Merge(entry.second);
+
+  groups.emplace_back("Total", total);
+
+  // Balance at the end of periods, not of tasks
+  bool display_balance = Group_Task != group && task.empty();
+
+  // Collect cells, to determine column widths
+  std::vector<std::string> cells = {
+      GetGroupTitle(group), "Entries", "Σ", "Ø", "Min", "Max"};
+
+  if (display_balance) cells.emplace_back("Balance");
+
+  for (const auto &[key, aggregate] : groups) {
+    int minutes_average =
+        (aggregate.sum + aggregate.amount / 2) / aggregate.amount;
+
+    cells.push_back(key);
+    cells.push_back(helper::Numeric::ToString(aggregate.amount));
+
+    for (int minutes : {
+        aggregate.sum, minutes_average, aggregate.min, aggregate.max}) {
+      cells.push_back(helper::DateTime::GetHoursFormattedFromMinutes(minutes));
+    }
+
+    if (display_balance) {
+      cells.push_back(
+          aggregate.has_balance
+          ? helper::DateTime::GetHoursFormattedFromMinutes(aggregate.balance)
+          : "");
+    }
+  }
+
+  size_t amount_columns = display_balance ? 7 : 6;
+
+  std::vector<int> widths(amount_columns, 0);
+
+  for (size_t index = 0; index < cells.size(); ++index) {
+    widths[index % amount_columns] = std::max(
+        widths[index % amount_columns],
+        helper::String::GetDisplayWidth(cells[index]));
+  }
+
+  std::string output;
+
+  for (size_t index = 0; index < cells.size(); ++index) {
+    size_t index_column = index % amount_columns;
+
+    std::string padding(
+        widths[index_column] - helper::String::GetDisplayWidth(cells[index]),
+        ' ');
+
+    output.append(0 == index_column ? " " : " | ");
+
+    // Group names are aligned left, figures right
+    if (0 == index_column || index < amount_columns) {
+      output.append(cells[index]).append(padding);
+    } else {
+      output.append(padding).append(cells[index]);
+    }
+
+    if (amount_columns - 1 == index_column) output.append("\n");
+  }
+
+  std::cout << output;
+
+  return true;
+}
+
+// Aggregate rows of the timesheet, within given dates if not 0
+bool ReportStats::AggregateTimesheet(
+    Groups group,
+    uint32_t date_first,
+    uint32_t date_last,
+    const std::string &task,
+    int minutes_now,
+    Aggregates *aggregates) {
+  std::string html;
+
+  if (!helper::File::ReadFile(
+      AppConfig::GetInstance().GetReportFilePath(), &html)) {
+    return AppError::PrintError("Cannot read timesheet.");
+  }
+
+  std::string_view rows;
+
+  if (!ReportParser::GetTableRows(html, &rows)) {
+    return AppError::PrintError("Cannot parse timesheet.");
+  }
+
+  if (0 != date_first) {
+    size_t offset_begin =
+        FindOffsetRowFromDate(rows, 0, rows.size(), date_first);
+
+    size_t offset_end =
+        FindOffsetRowFromDate(rows, offset_begin, rows.size(), date_last + 1);
+
+    rows = rows.substr(offset_begin, offset_end - offset_begin);
+  }
+
+  std::vector<size_t> offsets_chunks = GetOffsetsChunks(rows);
+
+  std::vector<Aggregates> chunks(offsets_chunks.size() - 1);
+
+  helper::System::ForEachInRange(
+      chunks.size(),
+      1,
+      [&](size_t index_begin, size_t index_end) {
+        for (size_t index = index_begin; index < index_end; ++index) {
+          AggregateRows(
+              rows.substr(
+                  offsets_chunks[index],
+                  offsets_chunks[index + 1] - offsets_chunks[index]),
+              group,
+              task,
+              minutes_now,
+              &chunks[index]);
+        }
+      });
+
+  // Merge in order of the chunks, so the latest balance prevails
+  *aggregates = std::move(chunks[0]);
+
+  for (size_t index = 1; index < chunks.size(); ++index) {
+    for (const auto &[key, aggregate] : chunks[index]) {
+      (*aggregates)[key].Merge(aggregate);
+    }
+  }
+
+  return true;
+}
+
+// Aggregate precomputed weekly or monthly rollups of the timesheet,
+// within the months of given dates if not 0
+bool ReportStats::AggregateRollups(
+    Groups group,
+    uint32_t date_first,
+    uint32_t date_last,
+    const std::string &task,
+    int minutes_now,
+    Aggregates *aggregates) {
+  ReportRollups::Rollups rollups;
+
+  if (!ReportRollups::Get(&rollups)) {
+    return AppError::PrintError("Cannot read timesheet.");
+  }
+
+  std::string month_first = "0000/00";
+  std::string month_last = "9999/99";
+
+  if (0 != date_first) {
+    month_first = std::to_string(date_first / 10000)
+        .append("/").append(ToStringPadded(date_first / 100 % 100));
+
+    month_last = std::to_string(date_last / 10000)
+        .append("/").append(ToStringPadded(date_last / 100 % 100));
+  }
+
+  // Keys of months and weeks are sorted chronologically
+  const auto &periods = Group_Week == group ? rollups.weeks : rollups.months;
+
+  for (const auto &[key, period] : periods) {
+    if (Group_Week != group && (key < month_first || key > month_last)) {
+      continue;
+    }
+
+    if (Group_Task == group) {
+      for (const auto &[task_in_period, aggregate] : period.tasks) {
+        if (task.empty() || task == task_in_period) {
+          (*aggregates)[task_in_period].Merge(aggregate);
+        }
+      }
+
+      continue;
+    }
+
+    const Aggregate *aggregate = &period.total;
+
+    if (!task.empty()) {
+      auto task_in_period = period.tasks.find(task);
+
+      if (task_in_period == period.tasks.end()) continue;
+
+      aggregate = &task_in_period->second;
+    }
+
+    (*aggregates)[Group_Year == group ? key.substr(0, 4) : key]
+        .Merge(*aggregate);
+  }
+
+  // Durations of ongoing entries aren't rolled up, they keep growing
+  for (const ReportRollups::Ongoing &ongoing : rollups.ongoing) {
+    if ((Group_Week != group
+            && (ongoing.month < month_first || ongoing.month > month_last))
+        || (!task.empty() && task != ongoing.task)) {
+      continue;
+    }
+
+    std::string key;
+
+    switch (group) {
+      case Group_Task:
+        key = ongoing.task;
+        break;
+      case Group_Week:
+        key = ongoing.week;
+        break;
+      case Group_Year:
+        key = ongoing.month.substr(0, 4);
+        break;
+      default:
+        key = ongoing.month;
+        break;
+    }
+
+    (*aggregates)[key].Add(
+        GetMinutesOfEntry(true, ongoing.start, "", minutes_now));
+  }
+
+  // Periods of only ongoing entries not within the filters
+  for (auto it = aggregates->begin(); it != aggregates->end();) {
+    it = 0 == it->second.amount ? aggregates->erase(it) : std::next(it);
+  }
+
+  return true;
+}
+
+// Get offsets to split given rows at into one chunk per worker thread
+std::vector<size_t> ReportStats::GetOffsetsChunks(std::string_view rows) {
+  size_t amount_chunks = std::max(
+      static_cast<size_t>(1),
+      std::min(
+          static_cast<size_t>(std::thread::hardware_concurrency()),
+          rows.size() / kMinLenRowsPerThread));
+
+  std::vector<size_t> offsets_chunks{0};
+
+  // Split at row boundaries
+  for (size_t index = 1; index < amount_chunks; ++index) {
+    size_t offset = rows.find("<tr", rows.size() * index / amount_chunks);
+
+    if (std::string_view::npos == offset) break;
+
+    if (offset > offsets_chunks.back()) offsets_chunks.push_back(offset);
+  }
+
+  offsets_chunks.push_back(rows.size());
+
+  return offsets_chunks;
+}
+
+// Aggregate rows of given columnar export, within given dates if not 0
+bool ReportStats::AggregateColumnar(
+    Groups group,
+    uint32_t date_first,
+    uint32_t date_last,
+    const std::string &task,
+    int minutes_now,
+    const std::string &path_columnar,
+    Aggregates *aggregates) {
+  ReportColumnar columnar;
+
+  if (!columnar.Map(path_columnar)) {
+    return AppError::PrintError("Cannot read columnar export.");
+  }
+
+  const ReportColumnar::Columns &columns = columnar.GetColumns();
+
+  // Rows are sorted by date: bisect the dates column
+  const uint32_t *dates_begin = columns.dates;
+  const uint32_t *dates_end = columns.dates + columns.amount_rows;
+
+  if (0 != date_first) {
+    dates_begin = std::lower_bound(dates_begin, dates_end, date_first);
+    dates_end = std::upper_bound(dates_begin, dates_end, date_last);
+  }
+
+  uint32_t index_task = task.empty()
+                        ? columns.amount_tasks
+                        : columnar.FindTask(task);
+
+  if (!task.empty() && index_task == columns.amount_tasks) return true;
+
+  // Aggregate by numeric key, convert keys to strings per group only
+  std::unordered_map<uint32_t, Aggregate> aggregates_by_key;
+
+  auto index_end = static_cast<uint32_t>(dates_end - columns.dates);
+
+  for (auto index = static_cast<uint32_t>(dates_begin - columns.dates);
+       index < index_end;
+       ++index) {
+    if (!task.empty() && columns.tasks[index] != index_task) continue;
+
+    uint32_t date = columns.dates[index];
+    uint32_t key;
+
+    switch (group) {
+      case Group_Task:
+        key = columns.tasks[index];
+        break;
+      case Group_Day:
+        key = date;
+        break;
+      case Group_Week:
+        key = date / 10000 * 100 + columns.weeks[index];
+        break;
+      case Group_Month:
+        key = date / 100;
+        break;
+      case Group_Year:
+      case Group_Invalid:
+      default:
+        key = date / 10000;
+    }
+
+    int minutes = 0;
+
+    if (ReportColumnar::kEmpty != columns.durations[index]) {
+      minutes = columns.durations[index];
+    } else if ((columns.flags[index] & ReportColumnar::kFlagOngoing)
+        && ReportColumnar::kEmpty != columns.starts[index]) {
+      minutes = std::max(0, minutes_now - columns.starts[index]);
+    }
+
+    Aggregate &aggregate = aggregates_by_key[key];
+
+    aggregate.Add(minutes);
+
+    if (ReportColumnar::kEmpty != columns.balances[index]) {
+      aggregate.balance = columns.balances[index];
+      aggregate.has_balance = true;
+    }
+  }
+
+  for (const auto &[key, aggregate] : aggregates_by_key) {
+    std::string key_group;
+
+    switch (group) {
+      case Group_Task:
+        key_group = GetGroupKey(group, 0, 0, columnar.GetTask(key));
+        break;
+      case Group_Day:
+        key_group = GetGroupKey(group, key, 0, "");
+        break;
+      case Group_Week:
+        key_group = GetGroupKey(
+            group, key / 100 * 10000, static_cast<int>(key % 100), "");
+        break;
+      case Group_Month:
+        key_group = GetGroupKey(group, key * 100, 0, "");
+        break;
+      case Group_Year:
+      case Group_Invalid:
+      default:
+        key_group = GetGroupKey(group, key * 10000, 0, "");
+    }
+
+    (*aggregates)[key_group] = aggregate;
+  }
+
+  return true;
+}
+
+// Get offset of the 1st row dated on or after given date: bisect over the
+// offsets, checking the 1st row starting at or after the probed one
+size_t ReportStats::FindOffsetRowFromDate(
+    std::string_view rows,
+    size_t offset_begin,
+    size_t offset_end,
+    uint32_t date) {
+  size_t offset_low = offset_begin;
+  size_t offset_high = offset_end;
+
+  while (offset_low < offset_high) {
+    size_t offset_middle = offset_low + (offset_high - offset_low) / 2;
+    size_t offset_tr = rows.find("<tr", offset_middle);
+
+    if (offset_tr >= offset_high || GetDateOfRow(rows, offset_tr) >= date) {
+      offset_high = offset_middle;
+    } else {
+      offset_low = offset_tr + 1;
+    }
+  }
+
+  return std::min(rows.find("<tr", offset_low), offset_end);
+}
+
+uint32_t ReportStats::GetDateOfRow(std::string_view rows, size_t offset_tr) {
+  size_t offset_meta = rows.find("meta\">", offset_tr);
+
+  if (std::string_view::npos == offset_meta) return 0;
+
+  offset_meta += std::strlen("meta\">");
+
+  return ReportMeta::GetDate(ReportMeta::Encode(
+      rows.substr(offset_meta, rows.find('<', offset_meta) - offset_meta)));
+}
+
+// Aggregate given rows into given hash map
+void ReportStats::AggregateRows(
+    std::string_view rows,
+    Groups group,
+    const std::string &task,
+    int minutes_now,
+    Aggregates *aggregates) {
+  std::string_view cells[Report::Index_Balance + 1];
+  std::string_view row;
+
+  for (size_t offset = 0; ReportParser::GetNextRow(rows, &offset, &row);) {
+    if (ReportParser::GetCellsOfRow(row, cells, Report::Index_Balance + 1)
+            <= Report::Index_Duration
+        || (!task.empty() && cells[Report::Index_Issue] != task)) {
+      continue;
+    }
+
+    uint64_t timestamp = ReportMeta::Encode(cells[Report::Index_Meta]);
+
+    Aggregate &aggregate = (*aggregates)[
+        GetGroupKey(group, timestamp, cells[Report::Index_Issue])];
+
+    aggregate.Add(GetMinutesOfEntry(
+        ReportMeta::IsOngoing(timestamp),
+        cells[Report::Index_Start],
+        cells[Report::Index_Duration],
+        minutes_now));
+
+    aggregate.SetBalance(cells[Report::Index_Balance]);
+  }
+}
+
+// Get key of group of given entry
+std::string ReportStats::GetGroupKey(
+    Groups group,
+    uint64_t timestamp,
+    std::string_view task) {
+  return GetGroupKey(
+      group,
+      ReportMeta::GetDate(timestamp),
+      ReportMeta::GetWeek(timestamp),
+      task);
+}
+
+// Get key of group of given date (yyyymmdd), week and task
+std::string ReportStats::GetGroupKey(
+    Groups group,
+    uint32_t date,
+    int week,
+    std::string_view task) {
+  uint32_t year = date / 10000;
+  uint32_t month = date / 100 % 100;
+
+  switch (group) {
+    case Group_Task:
+      return task.empty() ? "-" : std::string(task);
+    case Group_Day:
+      return std::to_string(year)
+          .append("/").append(ToStringPadded(month))
+          .append("/").append(ToStringPadded(date % 100));
+    case Group_Week:
+      // Weeks of the meta column (%W) don't span the turn of the year
+      return std::to_string(year).append("-W").append(
+          ToStringPadded(static_cast<uint32_t>(week)));
+    case Group_Month:
+      return std::to_string(year).append("/").append(ToStringPadded(month));
+    case Group_Year:
+    case Group_Invalid:
+    default:
+      return std::to_string(year);
+  }
+}
+
+// Get minutes of given entry's duration, or time passed since its start
+int ReportStats::GetMinutesOfEntry(
+    bool is_ongoing,
+    std::string_view start,
+    std::string_view duration,
+    int minutes_now) {
+  if (!duration.empty()) {
+    return helper::DateTime::GetSumMinutesFromTime(duration);
+  }
+
+  if (!is_ongoing || start.empty()) return 0;
+
+  return std::max(
+      0, minutes_now - helper::DateTime::GetSumMinutesFromTime(start));
+}
+
+std::string ReportStats::ToStringPadded(uint32_t number) {
+  return number < 10
+         ? "0" + std::to_string(number)
+         : std::to_string(number);
+}
+
+std::string ReportStats::GetGroupTitle(Groups group) {
+  switch (group) {
+    case Group_Task:
+      return "Task";
+    case Group_Day:
+      return "Day";
+    case Group_Week:
+      return "Week";
+    case Group_Month:
+      return "Month";
+    case Group_Year:
+    case Group_Invalid:
+    default:
+      return "Year";
+  }
+}
+
+// Order of keys: dates chronologically, task numbers numerically
+bool ReportStats::IsKeyBefore(
+    const std::string &key,
+    const std::string &other) {
+  bool is_numeric = std::all_of(key.begin(), key.end(), ::isdigit);
+  bool is_numeric_other = std::all_of(other.begin(), other.end(), ::isdigit);
+
+  if (is_numeric && is_numeric_other && key.size() != other.size()) {
+    return key.size() < other.size();
+  }
+
+  return key < other;
+}
+
+}  // namespace tictac_track
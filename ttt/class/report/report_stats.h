@@ -0,0 +1,193 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_STATS_H_
+#define TTT_CLASS_REPORT_REPORT_STATS_H_
+
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/app/app_error.h>
+#include <ttt/class/report/report.h>
+#include <ttt/class/report/report_meta.h>
+
+#include <ttt/helper/helper_date_time.h>
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_numeric.h>
+#include <ttt/helper/helper_string.h>
+#include <ttt/helper/helper_system.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tictac_track {
+
+// Aggregate durations of timesheet entries grouped by task, day, week, month
+// or year: sum, amount, average, minimum and maximum. Entries are aggregated
+// in a single pass (on multiple threads for large timesheets) into hash maps.
+// Rows are sorted by date, so those of a given period are located by
+// bisection, w/o parsing the rows before and after it
+class ReportStats {
+ public:
+  enum Groups {
+    Group_Task,
+    Group_Day,
+    Group_Week,
+    Group_Month,
+    Group_Year,
+    Group_Invalid
+  };
+
+  // Aggregated durations of a group, in minutes,
+  // and the balance after its latest entry that has one
+  struct Aggregate {
+    int sum = 0;
+    int amount = 0;
+    int min = 0;
+    int max = 0;
+    int balance = 0;
+    bool has_balance = false;
+
+    void Add(int minutes);
+    void SetBalance(std::string_view balance_cell);
+
+    // Merge given aggregate of later entries
+    void Merge(const Aggregate &other);
+  };
+
+  static Groups ResolveGroupByName(const std::string &name);
+
+  // Parse period given as "yyyy", "yyyy/mm", "yyyy/mm/dd" or a range of
+  // those: "<from>-<to>", into first and last date as yyyymmdd
+  static bool ParsePeriod(
+      const std::string &period,
+      uint32_t *date_first,
+      uint32_t *date_last);
+
+  // Aggregate entries within given period (all if empty),
+  // of given task only (if not -1), print table of groups.
+  // Entries are read from given columnar export, if any
+  static bool Print(
+      Groups group,
+      const std::string &period,
+      int task_number,
+      const std::string &path_columnar = "");
+
+  // Get offsets to split given rows at into one chunk per worker thread,
+  // incl. 0 and the end of the rows
+  static std::vector<size_t> GetOffsetsChunks(std::string_view rows);
+
+  // Get key of group of given entry
+  static std::string GetGroupKey(
+      Groups group,
+      uint64_t timestamp,
+      std::string_view task);
+
+  // Get key of group of given date (yyyymmdd), week and task
+  static std::string GetGroupKey(
+      Groups group,
+      uint32_t date,
+      int week,
+      std::string_view task);
+
+  // Get minutes of given entry's duration, or time passed since its start
+  // if ongoing (as summed up in views)
+  static int GetMinutesOfEntry(
+      bool is_ongoing,
+      std::string_view start,
+      std::string_view duration,
+      int minutes_now);
+
+ private:
+  // Minimum length of rows per thread, when aggregating on multiple threads
+  static constexpr size_t kMinLenRowsPerThread = 1048576;
+
+  using Aggregates = std::unordered_map<std::string, Aggregate>;
+
+  // Aggregate rows of the timesheet, within given dates if not 0
+  static bool AggregateTimesheet(
+      Groups group,
+      uint32_t date_first,
+      uint32_t date_last,
+      const std::string &task,
+      int minutes_now,
+      Aggregates *aggregates);
+
+  // Aggregate precomputed weekly or monthly rollups of the timesheet,
+  // within the months of given dates if not 0
+  static bool AggregateRollups(
+      Groups group,
+      uint32_t date_first,
+      uint32_t date_last,
+      const std::string &task,
+      int minutes_now,
+      Aggregates *aggregates);
+
+  // Aggregate rows of given columnar export, within given dates if not 0
+  static bool AggregateColumnar(
+      Groups group,
+      uint32_t date_first,
+      uint32_t date_last,
+      const std::string &task,
+      int minutes_now,
+      const std::string &path_columnar,
+      Aggregates *aggregates);
+
+  // Get offset of the 1st row dated on or after given date,
+  // bisecting given range of given rows (sorted by date)
+  static size_t FindOffsetRowFromDate(
+      std::string_view rows,
+      size_t offset_begin,
+      size_t offset_end,
+      uint32_t date);
+
+  static uint32_t GetDateOfRow(std::string_view rows, size_t offset_tr);
+
+  // Aggregate given rows into given hash map
+  static void AggregateRows(
+      std::string_view rows,
+      Groups group,
+      const std::string &task,
+      int minutes_now,
+      Aggregates *aggregates);
+
+  // Format given number w/ at least two digits
+  static std::string ToStringPadded(uint32_t number);
+
+  static std::string GetGroupTitle(Groups group);
+
+  // Order of keys: dates chronologically, task numbers numerically
+  static bool IsKeyBefore(const std::string &key, const std::string &other);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_STATS_H_
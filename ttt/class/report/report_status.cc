@@ -0,0 +1,274 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_status.h>
+
+namespace tictac_track {
+
+// Rebuild the sidecar from the latest day of the timesheet
+bool ReportStatus::Update() {
+  State state{};
+
+  if (Collect(&state)) return Save(state);
+
+  // Timesheet is gone: so is its status
+  std::string path = GetPath();
+
+  if (helper::File::FileExists(path)) helper::File::Remove(path.c_str());
+
+  return false;
+}
+
+// Print status, w/ placeholders of given template replaced
+bool ReportStatus::Print(std::string format) {
+  State state{};
+
+  if (!Load(&state)) {
+    // Sidecar is missing or outdated, e.g. after modifications by older
+    // versions of ttt: rebuild it. Concurrent readers may do so as well,
+    // each replaces the sidecar atomically from its own temporary file
+    ReportLock::Acquire(AppCommand::Command_View, false);
+
+    bool is_collected = Collect(&state);
+
+    if (is_collected) Save(state);
+
+    ReportLock::Release();
+
+    if (!is_collected) return AppError::PrintError("Cannot read timesheet.");
+  }
+
+  if (format.empty()) {
+    format = 0 == state.time_started
+             ? "No ongoing entry, today %d, balance %b"
+             : '\0' == state.task[0]
+               ? "Ongoing entry, %e elapsed, today %d, balance %b"
+               : "Ongoing task %t, %e elapsed, today %d, balance %b";
+  }
+
+  std::cout << Format(format, state) << "\n";
+
+  return true;
+}
+
+std::string ReportStatus::GetPath() {
+  return AppConfig::GetInstance().GetReportFilePath() + ".status";
+}
+
+// Collect state from the latest day of the timesheet
+bool ReportStatus::Collect(State *state) {
+  std::memset(state, 0, sizeof *state);
+  std::memcpy(state->magic, "TTTS", sizeof state->magic);
+  state->version = kVersion;
+
+  if (!StatTimesheet(&state->size_file, &state->time_modified)) return false;
+
+  ReportTail tail;
+
+  // Timesheet w/o entries
+  if (!tail.LoadReportTail()) return true;
+
+  int index_last = tail.GetAmountRows() - 1;
+
+  if (index_last < 0) return true;
+
+  state->date_latest = ReportMeta::GetDate(ReportMeta::Encode(
+      tail.GetColumnContent(index_last, Report::Index_Meta)));
+
+  state->minutes_day = GetMinutesFromCell(
+      tail.GetColumnContent(index_last, Report::Index_SumDay));
+
+  state->minutes_balance = GetMinutesFromCell(
+      tail.GetColumnContent(index_last, Report::Index_Balance));
+
+  for (int index = index_last; index >= 0; --index) {
+    std::string meta = tail.GetColumnContent(index, Report::Index_Meta);
+
+    if (meta.empty() || 's' != meta[0]) continue;
+
+    std::string start = tail.GetColumnContent(index, Report::Index_Start);
+
+    uint32_t date = ReportMeta::GetDate(ReportMeta::Encode(meta));
+    int minutes_start = helper::DateTime::GetSumMinutesFromTime(start);
+
+    std::tm time_start{};
+    time_start.tm_year = static_cast<int>(date / 10000) - 1900;
+    time_start.tm_mon = static_cast<int>(date / 100 % 100) - 1;
+    time_start.tm_mday = static_cast<int>(date % 100);
+    time_start.tm_hour = minutes_start / 60;
+    time_start.tm_min = minutes_start % 60;
+    time_start.tm_isdst = -1;
+
+    state->time_started = static_cast<int64_t>(std::mktime(&time_start));
+
+    CopyTruncated(start, state->start, sizeof state->start);
+
+    CopyTruncated(
+        tail.GetColumnContent(index, Report::Index_Issue),
+        state->task,
+        sizeof state->task);
+
+    CopyTruncated(
+        helper::Html::Decode(
+            tail.GetColumnContent(index, Report::Index_Comment)),
+        state->comment,
+        sizeof state->comment);
+
+    break;
+  }
+
+  return true;
+}
+
+// Load sidecar, if it matches the timesheet
+bool ReportStatus::Load(State *state) {
+  int fd = open(GetPath().c_str(), O_RDONLY);
+  if (-1 == fd) return false;
+
+  ssize_t length = read(fd, state, sizeof *state);
+
+  close(fd);
+
+  uint64_t size_file;
+  int64_t time_modified;
+
+  return sizeof *state == static_cast<size_t>(length)
+      && 0 == std::memcmp(state->magic, "TTTS", sizeof state->magic)
+      && kVersion == state->version
+      && StatTimesheet(&size_file, &time_modified)
+      && size_file == state->size_file
+      && time_modified == state->time_modified;
+}
+
+bool ReportStatus::Save(const State &state) {
+  return helper::File::ReplaceFile(
+      GetPath(),
+      std::string(reinterpret_cast<const char *>(&state), sizeof state));
+}
+
+bool ReportStatus::StatTimesheet(uint64_t *size_file, int64_t *time_modified) {
+  return helper::File::GetSizeAndTimeModified(
+      AppConfig::GetInstance().GetReportFilePath(), size_file, time_modified);
+}
+
+// Get minutes of given "hh:mm" cell content, 0 if empty
+int ReportStatus::GetMinutesFromCell(const std::string &content) {
+  return content.empty()
+         ? 0
+         : helper::DateTime::GetSumMinutesFromTime(content);
+}
+
+// Copy given string into given fixed-size, zero-terminated buffer,
+// w/o cutting UTF-8 sequences
+void ReportStatus::CopyTruncated(
+    const std::string &source,
+    char *buffer,
+    size_t size) {
+  size_t length = std::min(source.size(), size - 1);
+
+  if (length < source.size()) {
+    // Don't start cutting at a continuation byte
+    while (length > 0
+        && 0x80 == (static_cast<unsigned char>(source[length]) & 0xC0)) {
+      --length;
+    }
+  }
+
+  std::memcpy(buffer, source.data(), length);
+  buffer[length] = '\0';
+}
+
+std::string ReportStatus::Format(
+    const std::string &format,
+    const State &state) {
+  bool is_ongoing = 0 != state.time_started;
+
+  auto time_now = static_cast<int64_t>(std::time(nullptr));
+
+  int minutes_elapsed = is_ongoing
+      ? static_cast<int>(std::max(
+          static_cast<int64_t>(0), (time_now - state.time_started) / 60))
+      : 0;
+
+  // Sum of the latest day is today's only if that day is today
+  int minutes_day = minutes_elapsed;
+
+  if (state.date_latest == static_cast<uint32_t>(helper::String::ToInt(
+      helper::DateTime::GetCurrentTimeFormatted("%Y%m%d")))) {
+    minutes_day += state.minutes_day;
+  }
+
+  int minutes_balance = state.minutes_balance + minutes_elapsed;
+
+  std::string formatted;
+
+  for (size_t index = 0; index < format.size(); ++index) {
+    if ('%' != format[index] || index + 1 == format.size()) {
+      formatted += format[index];
+
+      continue;
+    }
+
+    switch (format[++index]) {
+      case 't':
+        formatted.append(state.task);
+        break;
+      case 'c':
+        formatted.append(state.comment);
+        break;
+      case 's':
+        formatted.append(state.start);
+        break;
+      case 'e':
+        if (is_ongoing) {
+          formatted.append(
+              helper::DateTime::GetHoursFormattedFromMinutes(minutes_elapsed));
+        }
+        break;
+      case 'd':
+        formatted.append(
+            helper::DateTime::GetHoursFormattedFromMinutes(minutes_day));
+        break;
+      case 'b':
+        if (minutes_balance > 0) formatted += '+';
+
+        formatted.append(
+            helper::DateTime::GetHoursFormattedFromMinutes(minutes_balance));
+        break;
+      case '%':
+        formatted += '%';
+        break;
+      default:
+        formatted += '%';
+        formatted += format[index];
+        break;
+    }
+  }
+
+  return formatted;
+}
+
+}  // namespace tictac_track
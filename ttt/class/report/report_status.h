@@ -0,0 +1,115 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_STATUS_H_
+#define TTT_CLASS_REPORT_REPORT_STATUS_H_
+
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/app/app_error.h>
+#include <ttt/class/report/report_lock.h>
+#include <ttt/class/report/report_meta.h>
+#include <ttt/class/report/report_tail.h>
+
+#include <ttt/helper/helper_date_time.h>
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_html.h>
+#include <ttt/helper/helper_string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+namespace tictac_track {
+
+// Fixed-size sidecar of the timesheet (timesheet.html.status), holding what
+// status lines need: the ongoing entry's start, task and comment, the latest
+// day's sum and the balance. Updated after every modification, so querying
+// the status reads only the sidecar, not the timesheet. A sidecar not
+// matching the timesheet's size and modification time is rebuilt
+class ReportStatus {
+ public:
+  // Rebuild the sidecar from the latest day of the timesheet
+  static bool Update();
+
+  // Print status, w/ placeholders of given template replaced:
+  // %t task, %c comment, %s start, %e elapsed, %d day sum, %b balance
+  static bool Print(std::string format = "");
+
+ private:
+  static const uint32_t kVersion = 1;
+
+  static const size_t kLenTask = 32;
+  static const size_t kLenComment = 192;
+
+  struct State {
+    char magic[4];
+    uint32_t version;
+
+    // Size and modification time (ns) of the timesheet this state is of
+    uint64_t size_file;
+    int64_t time_modified;
+
+    // Latest day w/ entries as yyyymmdd, 0 if there are none
+    uint32_t date_latest;
+
+    int32_t minutes_day;
+    int32_t minutes_balance;
+
+    // Ongoing entry: start as unix time (0 if none), task and comment
+    int64_t time_started;
+    char start[8];
+    char task[kLenTask];
+    char comment[kLenComment];
+  };
+
+  static std::string GetPath();
+
+  // Collect state from the latest day of the timesheet
+  static bool Collect(State *state);
+
+  // Load sidecar, if it matches the timesheet
+  static bool Load(State *state);
+
+  static bool Save(const State &state);
+
+  static bool StatTimesheet(uint64_t *size_file, int64_t *time_modified);
+
+  static int GetMinutesFromCell(const std::string &content);
+
+  static void CopyTruncated(
+      const std::string &source,
+      char *buffer,
+      size_t size);
+
+  static std::string Format(const std::string &format, const State &state);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_STATUS_H_
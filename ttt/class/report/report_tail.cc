@@ -0,0 +1,339 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_tail.h>
+
+namespace tictac_track {
+
+// Load rows of latest day, and balance of the day before them:
+// read growing chunks backwards from the end of the file until the row
+// before the latest day or the table head is reached
+bool ReportTail::LoadReportTail() {
+  path_ = AppConfig::GetInstance().GetReportFilePath();
+
+  int fd = open(path_.c_str(), O_RDONLY);
+  if (-1 == fd) return false;
+
+  struct stat file_stat{};
+  if (-1 == fstat(fd, &file_stat)) {
+    close(fd);
+
+    return false;
+  }
+
+  auto size_file = static_cast<size_t>(file_stat.st_size);
+
+  size_t length = kChunkSize;
+  int result = 0;
+  std::string buffer;
+
+  while (0 == result) {
+    if (length > size_file) length = size_file;
+
+    size_t offset = size_file - length;
+
+    if (!helper::File::ReadFileRange(fd, offset, length, &buffer)) break;
+
+    result = ExtractTail(buffer, offset);
+
+    if (0 == offset) break;
+
+    length *= 4;
+  }
+
+  close(fd);
+
+  return 1 == result;
+}
+
+// Extract tail from given end-part of the timesheet.
+// Returns 1 if found, 0 if more of the file is needed, -1 if malformed
+int ReportTail::ExtractTail(std::string &buffer, size_t offset_buffer) {
+  size_t offset_table_end = buffer.rfind("</table>");
+
+  if (std::string::npos == offset_table_end) return -1;
+
+  size_t offset_thead_end = buffer.find("</thead>");
+
+  SetHtml(std::move(buffer));
+
+  std::string date_last;
+  size_t offset_day_start = std::string::npos;
+  size_t offset_tr = offset_table_end;
+
+  while (true) {
+    offset_tr = 0 == offset_tr
+        ? std::string::npos
+        : html_.rfind("<tr", offset_tr - 1);
+
+    if (std::string::npos == offset_tr
+        || (std::string::npos != offset_thead_end
+            && offset_tr < offset_thead_end)) {
+      // Reached head: all entries are of the latest day
+      if (std::string::npos == offset_thead_end) {
+        return 0 == offset_buffer ? -1 : 0;
+      }
+
+      // No entries at all
+      if (std::string::npos == offset_day_start) return -1;
+
+      balance_initial_ = 0;
+
+      break;
+    }
+
+    std::string date =
+        GetColumnContent(0, ColumnIndexes::Index_Date, offset_tr);
+
+    if (date.empty()) return -1;
+
+    if (date_last.empty()) date_last = date;
+
+    if (date == date_last) {
+      offset_day_start = offset_tr;
+
+      continue;
+    }
+
+    // Last entry of the day before: its balance is continued
+    std::string balance =
+        GetColumnContent(0, ColumnIndexes::Index_Balance, offset_tr);
+
+    if (balance.empty()) return -1;
+
+    balance_initial_ = helper::DateTime::GetSumMinutesFromTime(balance);
+
+    break;
+  }
+
+  size_t offset_tail = offset_day_start;
+
+  if (offset_tail > 0 && '\n' == html_[offset_tail - 1]) --offset_tail;
+
+  offset_tail_ = offset_buffer + offset_tail;
+
+  SetHtml(kTHeadStub + html_.substr(offset_tail));
+
+  return 1;
+}
+
+// Write tail (and changed head) back, truncate the file after it
+bool ReportTail::SaveReportTail() {
+  int fd = open(path_.c_str(), O_RDWR);
+  if (-1 == fd) return false;
+
+  // Changed title can alter the length of the head, the tail moves along then
+  size_t offset_tail = offset_tail_ + head_.size() - head_length_read_;
+
+  std::string tail = html_.substr(std::strlen(kTHeadStub));
+
+  if (ReportBackup::IsRecording() && !RecordChanges(fd, offset_tail, tail)) {
+    close(fd);
+
+    return false;
+  }
+
+  bool result =
+      (head_.empty() || helper::File::WriteFileRange(fd, 0, head_))
+      && helper::File::WriteFileRange(fd, offset_tail, tail)
+      && 0 == ftruncate(fd, static_cast<off_t>(offset_tail + tail.size()));
+
+  close(fd);
+
+  return result;
+}
+
+// Record replaced head and tail for undo, reading only their old content
+bool ReportTail::RecordChanges(
+    int fd,
+    size_t offset_tail,
+    const std::string &tail) {
+  struct stat file_stat{};
+  if (-1 == fstat(fd, &file_stat)) return false;
+
+  auto size_file = static_cast<size_t>(file_stat.st_size);
+
+  std::string head_old;
+  std::string tail_old;
+
+  if ((!head_.empty()
+          && !helper::File::ReadFileRange(fd, 0, head_length_read_, &head_old))
+      || !helper::File::ReadFileRange(
+          fd, offset_tail_, size_file - offset_tail_, &tail_old)) {
+    return false;
+  }
+
+  if (!head_.empty()) ReportBackup::RecordChange(0, head_old, head_);
+
+  ReportBackup::RecordChange(offset_tail, tail_old, tail);
+
+  return true;
+}
+
+int ReportTail::GetBalanceInitial() const {
+  return balance_initial_;
+}
+
+// Check the part of the timesheet before the tail for an ongoing entry.
+// Only the latest entry can be ongoing: read backwards in chunks until the
+// last meta cell before the tail, instead of reading the whole prefix.
+// Unreadable counts as ongoing, so callers fall back to the whole timesheet
+bool ReportTail::IsAnyEntryOngoingBeforeTail() {
+  if (0 == offset_tail_) return false;
+
+  int fd = open(path_.c_str(), O_RDONLY);
+  if (-1 == fd) return true;
+
+  const std::string kTdMeta = "<td class=\"meta\">";
+
+  size_t offset_end = offset_tail_;
+
+  // Start of the chunk read before, to find cells split over two chunks
+  std::string chunk_next;
+
+  while (0 < offset_end) {
+    size_t length = std::min(kChunkSize, offset_end);
+    std::string chunk;
+
+    if (!helper::File::ReadFileRange(fd, offset_end - length, length, &chunk)) {
+      close(fd);
+
+      return true;
+    }
+
+    chunk += chunk_next;
+
+    size_t offset_meta = chunk.rfind(kTdMeta);
+
+    if (std::string::npos != offset_meta) {
+      close(fd);
+
+      return 0 == chunk.compare(offset_meta + kTdMeta.size(), 2, "s/");
+    }
+
+    offset_end -= length;
+    chunk_next = chunk.substr(0, kTdMeta.size() + 1);
+  }
+
+  close(fd);
+
+  return false;
+}
+
+// Update report title (in title- and h1-tag) to:
+// "timesheet <DATE_FIRST_ENTRY> - <given DATE_LAST_ENTRY>"
+bool ReportTail::UpdateHeadTitle(const std::string &date_last) {
+  size_t length = std::min(kChunkSize, offset_tail_);
+  size_t offset_thead_end;
+  size_t offset_row_end;
+
+  // Read head, including the 1st entry if that precedes the tail
+  while (true) {
+    if (!ReadPrefix(0, length, &head_)) return false;
+
+    offset_thead_end = head_.find("</thead>");
+
+    offset_row_end = std::string::npos == offset_thead_end
+        ? std::string::npos
+        : head_.find("</tr>", offset_thead_end);
+
+    if (std::string::npos != offset_row_end || length == offset_tail_) break;
+
+    length = std::min(length * 4, offset_tail_);
+  }
+
+  head_length_read_ = head_.size();
+
+  std::string date_first = std::string::npos == offset_row_end
+      ? GetColumnContent(0, ColumnIndexes::Index_Date)
+      : ReportParser(head_).GetColumnContent(0, ColumnIndexes::Index_Date);
+
+  AppLocale locale = AppLocale::GetInstance();
+  std::string title = locale.Translate("timesheet");
+  title = title.append(" ").append(date_first);
+
+  if (date_first != date_last) title.append(" - ").append(date_last);
+
+  auto offset_title_start = head_.find("<title>");
+  auto offset_title_end = head_.find("</title>");
+  auto offset_h1_start = head_.find("<h1>");
+  auto offset_h1_end = head_.find("</h1>");
+
+  if (std::string::npos == offset_title_end
+      || std::string::npos == offset_h1_end) {
+    head_.clear();
+    head_length_read_ = 0;
+
+    return false;
+  }
+
+  head_.replace(
+      offset_title_start + 7,
+      offset_title_end - offset_title_start - 7,
+      title);
+
+  offset_h1_start = head_.find("<h1>");
+  offset_h1_end = head_.find("</h1>");
+
+  head_.replace(offset_h1_start + 4, offset_h1_end - offset_h1_start - 4, title);
+
+  if (head_.size() == head_length_read_
+      || head_length_read_ == offset_tail_) return true;
+
+  // Length changed: the rest of the head must be moved too
+  std::string rest;
+
+  if (!ReadPrefix(
+      head_length_read_,
+      offset_tail_ - head_length_read_,
+      &rest)) {
+    head_.clear();
+    head_length_read_ = 0;
+
+    return false;
+  }
+
+  head_.append(rest);
+  head_length_read_ = offset_tail_;
+
+  return true;
+}
+
+bool ReportTail::ReadPrefix(
+    size_t offset,
+    size_t length,
+    std::string *content) {
+  int fd = open(path_.c_str(), O_RDONLY);
+  if (-1 == fd) return false;
+
+  bool result = helper::File::ReadFileRange(fd, offset, length, content);
+
+  close(fd);
+
+  return result;
+}
+
+}  // namespace tictac_track
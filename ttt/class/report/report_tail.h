@@ -0,0 +1,89 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_TAIL_H_
+#define TTT_CLASS_REPORT_REPORT_TAIL_H_
+
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/app/app_locale.h>
+#include <ttt/class/report/report_backup.h>
+#include <ttt/class/report/report_parser.h>
+
+#include <ttt/helper/helper_date_time.h>
+#include <ttt/helper/helper_file.h>
+
+#include <algorithm>
+#include <string>
+
+namespace tictac_track {
+
+// Latest day of the timesheet, read backwards from the end of the file.
+// Lets start/stop/comment of the latest entry rewrite only the file suffix
+// instead of loading, recalculating and saving the whole timesheet
+class ReportTail : public ReportParser {
+ public:
+  ReportTail() = default;
+
+  // Load rows of latest day, and balance of the day before them.
+  // Returns false if the timesheet has no entries or cannot be parsed
+  bool LoadReportTail();
+
+  // Write tail (and changed head) back, truncate the file after it
+  bool SaveReportTail();
+
+  [[nodiscard]] int GetBalanceInitial() const;
+
+  // Check the part of the timesheet before the tail for an ongoing entry
+  bool IsAnyEntryOngoingBeforeTail();
+
+  // Update report title in head to span the 1st entry's date until given date
+  bool UpdateHeadTitle(const std::string &date_last);
+
+ private:
+  static constexpr size_t kChunkSize = 16384;
+
+  std::string path_;
+
+  size_t offset_tail_ = 0;
+  int balance_initial_ = 0;
+
+  // Head of the file (up to the 1st entry) and its length before changing
+  std::string head_;
+  size_t head_length_read_ = 0;
+
+  // Extract tail from given end-part of the timesheet.
+  // Returns 1 if found, 0 if more of the file is needed, -1 if malformed
+  int ExtractTail(std::string &buffer, size_t offset_buffer);
+
+  bool ReadPrefix(size_t offset, size_t length, std::string *content);
+
+  // Record replaced head and tail for undo
+  bool RecordChanges(int fd, size_t offset_tail, const std::string &tail);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_TAIL_H_
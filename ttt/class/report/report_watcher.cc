@@ -0,0 +1,285 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/class/report/report_watcher.h>
+
+namespace tictac_track {
+
+// Watch latest given amount of rows or days, until "q" is pressed
+bool ReportWatcher::Watch(
+    int amount,
+    bool is_days,
+    int task_number,
+    std::string comment) {
+  amount_ = amount;
+  is_days_ = is_days;
+  task_number_ = task_number;
+  comment_ = std::move(comment);
+
+  path_ = AppConfig::GetInstance().GetReportFilePath();
+
+  size_t offset_filename = path_.rfind('/');
+
+  filename_ = std::string::npos == offset_filename
+              ? path_
+              : path_.substr(offset_filename + 1);
+
+  // Lock only while reading, other ttt processes can modify meanwhile
+  ReportLock::Release();
+
+  if (!helper::File::FileExists(path_)) {
+    return AppError::PrintError("Cannot read timesheet.");
+  }
+
+  is_terminal_ = helper::Tui::IsStdoutTerminal()
+      && helper::Tui::EnterCbreakMode();
+
+  // Frames are composed completely before being written
+  is_output_chunked_ = false;
+
+  int fd_watch = helper::File::WatchFile(path_);
+
+  if (is_terminal_) helper::Tui::EnterFullscreen();
+
+  Render();
+
+  while (true) {
+    // Negative descriptors are ignored by poll()
+    struct pollfd fds[2] = {
+        {fd_watch, POLLIN, 0},
+        {is_terminal_ ? STDIN_FILENO : -1, POLLIN, 0}};
+
+    int timeout_ms = GetMillisecondsUntilNextMinute();
+
+    if (-1 == fd_watch) timeout_ms = std::min(timeout_ms, kIntervalPollMs);
+
+    if (-1 == poll(fds, 2, timeout_ms)) {
+      if (EINTR == errno) continue;
+
+      break;
+    }
+
+    if (0 != (fds[1].revents & POLLIN)) {
+      int key = helper::Tui::ReadKey();
+
+      if (-1 == key || 'q' == key || 'Q' == key) break;
+    }
+
+    bool is_changed = -1 == fd_watch
+                      ? IsModified()
+                      : 0 != (fds[0].revents & POLLIN)
+                        && helper::File::ReadWatchEvents(fd_watch, filename_);
+
+    if (is_changed || GetCurrentMinute() != minute_rendered_) Render();
+  }
+
+  if (-1 != fd_watch) close(fd_watch);
+
+  if (is_terminal_) {
+    helper::Tui::LeaveFullscreen();
+    helper::Tui::RestoreTerminalMode();
+  }
+
+  return true;
+}
+
+// Has the timesheet file changed since it was rendered?
+bool ReportWatcher::IsModified() {
+  uint64_t size_file;
+  int64_t time_modified;
+
+  return !helper::File::GetSizeAndTimeModified(
+             path_, &size_file, &time_modified)
+      || size_file != size_file_
+      || time_modified != time_modified_;
+}
+
+int64_t ReportWatcher::GetCurrentMinute() {
+  return static_cast<int64_t>(std::time(nullptr)) / 60;
+}
+
+int ReportWatcher::GetMillisecondsUntilNextMinute() {
+  auto ms_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+
+  return static_cast<int>(60000 - ms_since_epoch % 60000);
+}
+
+// Set durations of ongoing entries to the time passed since their start,
+// the same way as they are summed up by AddSumMinutes()
+void ReportWatcher::UpdateDurationsOfOngoingEntries() {
+  for (int index_cell = 0;
+       index_cell + amount_columns_ <= static_cast<int>(cells_.size());
+       index_cell += amount_columns_) {
+    if ('s' != cells_[index_cell + Index_Meta][0]) continue;
+
+    std::string duration = helper::DateTime::GetHoursFormattedFromMinutes(
+        AddSumMinutes(index_cell, "", true, 0));
+
+    int width = GetCellWidth(Index_Duration, duration);
+
+    if (width > column_content_max_len_[Index_Duration]) {
+      column_content_max_len_[Index_Duration] = width;
+    }
+
+    cells_[index_cell + Index_Duration] = duration;
+  }
+}
+
+// Read and render the tail of the timesheet, display what changed
+void ReportWatcher::Render() {
+  helper::File::GetSizeAndTimeModified(
+      path_, &size_file_, &time_modified_);
+
+  minute_rendered_ = GetCurrentMinute();
+
+  cells_.clear();
+  column_titles_.clear();
+  column_content_max_len_.clear();
+  id_first_row_rendered_ = 0;
+
+  ReportLock::Acquire(AppCommand::Command_View, false);
+
+  bool is_extracted = ExtractPartsFromReportTail(amount_, is_days_);
+
+  ReportLock::Release();
+
+  output_.clear();
+
+  int amount_rows_printed = 0;
+
+  if (is_extracted) {
+    UpdateDurationsOfOngoingEntries();
+
+    max_index_digits_ =
+        helper::Numeric::GetAmountDigits(id_first_row_rendered_ + amount_rows_);
+
+    PrintHeader();
+
+    amount_rows_printed = PrintRows(task_number_, comment_);
+  }
+
+  std::string status = " ";
+
+  if (!is_extracted) {
+    status.append("Cannot read timesheet. ");
+  } else if (0 == amount_rows_printed) {
+    status.append("No entries found. ");
+  }
+
+  status
+    .append("Watching ")
+    .append(filename_)
+    .append(", updated ")
+    .append(helper::DateTime::GetCurrentTimeFormatted("%H:%M"))
+    .append(" ");
+
+  if (is_terminal_) status.append("| q: quit ");
+
+  std::vector<std::string> lines;
+
+  for (size_t offset = !output_.empty() && '\n' == output_[0] ? 1 : 0;
+       offset < output_.size();) {
+    size_t offset_end = output_.find('\n', offset);
+
+    if (std::string::npos == offset_end) offset_end = output_.size();
+
+    lines.emplace_back(output_, offset, offset_end - offset);
+
+    offset = offset_end + 1;
+  }
+
+  output_.clear();
+
+  if (!is_terminal_) {
+    // Print view only if it changed, the status line is not compared
+    if (lines == lines_drawn_) return;
+
+    lines_drawn_ = lines;
+
+    for (const auto &line : lines) output_.append(line).append("\n");
+
+    output_.append(status).append("\n");
+
+    FlushOutput();
+
+    return;
+  }
+
+  auto width = static_cast<size_t>(helper::System::GetMaxCharsPerTerminalRow());
+
+  if (width > 0 && status.size() > width) status.resize(width);
+
+  lines.push_back(ansi_format_inverted_ + status + ansi_format_reset_);
+
+  DrawChangedLines(lines);
+}
+
+// Redraw lines differing from those displayed
+void ReportWatcher::DrawChangedLines(std::vector<std::string> lines) {
+  int width = helper::System::GetMaxCharsPerTerminalRow();
+  int height = std::max(2, helper::System::GetAmountTerminalRows());
+
+  // Keep header and status line, cut rows off the top to fit
+  if (static_cast<int>(lines.size()) > height) {
+    lines.erase(lines.begin() + 1, lines.begin() + 1 + (lines.size() - height));
+  }
+
+  if (width != width_drawn_ || height != height_drawn_) {
+    lines_drawn_.clear();
+    width_drawn_ = width;
+    height_drawn_ = height;
+
+    output_.append("\033[H\033[J");
+  }
+
+  for (size_t index = 0; index < lines.size(); ++index) {
+    if (index < lines_drawn_.size() && lines[index] == lines_drawn_[index]) {
+      continue;
+    }
+
+    output_
+      .append("\033[")
+      .append(helper::Numeric::ToString(static_cast<int>(index) + 1))
+      .append(";1H")
+      .append(ansi_format_reset_)
+      .append(lines[index])
+      .append("\033[K");
+  }
+
+  if (lines.size() < lines_drawn_.size()) {
+    output_
+      .append("\033[")
+      .append(helper::Numeric::ToString(static_cast<int>(lines.size()) + 1))
+      .append(";1H\033[J");
+  }
+
+  lines_drawn_ = std::move(lines);
+
+  FlushOutput();
+}
+
+}  // namespace tictac_track
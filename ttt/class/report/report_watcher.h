@@ -0,0 +1,106 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_CLASS_REPORT_REPORT_WATCHER_H_
+#define TTT_CLASS_REPORT_REPORT_WATCHER_H_
+
+#include <ttt/class/report/report_lock.h>
+#include <ttt/class/report/report_renderer_cli.h>
+
+#include <ttt/helper/helper_date_time.h>
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_system.h>
+#include <ttt/helper/helper_tui.h>
+
+#include <poll.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace tictac_track {
+
+// Live view of the latest rows or days of the timesheet. The timesheet file
+// is watched via inotify (polled where unsupported): on modification only its
+// tail is read again. Ongoing entries' durations are updated once per minute.
+// In a terminal only lines that changed are redrawn, otherwise every changed
+// view is printed anew
+class ReportWatcher : public ReportRendererCli {
+ public:
+  // Watch latest given amount of rows or days, until "q" is pressed
+  bool Watch(
+      int amount,
+      bool is_days,
+      int task_number,
+      std::string comment = "");
+
+ private:
+  // Milliseconds between checks for modifications w/o inotify
+  static constexpr int kIntervalPollMs = 1000;
+
+  std::string path_;
+  std::string filename_;
+
+  int amount_ = 1;
+  bool is_days_ = true;
+  int task_number_ = -1;
+  std::string comment_;
+
+  bool is_terminal_ = false;
+
+  // Size and modification time (in nanoseconds) of the file when rendered
+  uint64_t size_file_ = 0;
+  int64_t time_modified_ = 0;
+
+  // Minute since epoch that was rendered
+  int64_t minute_rendered_ = 0;
+
+  // Lines currently displayed, and the terminal size they were drawn for
+  std::vector<std::string> lines_drawn_;
+  int width_drawn_ = 0;
+  int height_drawn_ = 0;
+
+  // Has the timesheet file changed since it was rendered?
+  bool IsModified();
+
+  static int64_t GetCurrentMinute();
+  static int GetMillisecondsUntilNextMinute();
+
+  // Set durations of ongoing entries to the time passed since their start
+  void UpdateDurationsOfOngoingEntries();
+
+  // Read and render the tail of the timesheet, display what changed
+  void Render();
+
+  // Redraw lines differing from those displayed
+  void DrawChangedLines(std::vector<std::string> lines);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_CLASS_REPORT_REPORT_WATCHER_H_
@@ -89,44 +89,82 @@ std::string DateTime::ReformatDateAsYyyyMmDd(
 
 // Calculate minutes since 0:00 from given formatted time label
 int DateTime::GetSumMinutesFromTime(
-    std::string time_str,
-    const char *separator) {
+    std::string_view time_str,
+    char separator) {
   if (time_str.empty()) {
-    time_str = GetCurrentTimeFormatted(FORMAT_TIME);
+    return GetSumMinutesFromTime(
+        GetCurrentTimeFormatted(FORMAT_TIME), separator);
   }
 
+  bool is_negative = '-' == time_str[0];
+
+  if (is_negative) time_str.remove_prefix(1);
+
   size_t offset_separator = time_str.find(separator);
 
-  if (std::string::npos == offset_separator) {
+  if (std::string_view::npos == offset_separator) {
     return 0;
   }
 
-  int hours = String::ToInt(time_str.substr(0, offset_separator).c_str());
-
-  int minutes = String::ToInt(
-      time_str.substr(offset_separator + 1, std::string::npos).c_str());
+  int minutes = ParseDigits(time_str.substr(0, offset_separator)) * 60
+      + ParseDigits(time_str.substr(offset_separator + 1));
 
-  return hours*60 + minutes;
+  return is_negative ? -minutes : minutes;
 }
 
-// Format given amount of minutes like "hh:mm".
-// Hours >= 24 are treated as being in next day (begin from 0 again)
-std::string DateTime::GetHoursFormattedFromMinutes(int minutes) {
-  bool is_negative = minutes < 0;
+// Parse given unsigned decimal, w/o allocating. Anything else results in 0
+int DateTime::ParseDigits(std::string_view digits) {
+  int number = 0;
 
-  if (is_negative) {
-    minutes *= -1;
-  }
+  for (char digit : digits) {
+    if (digit < '0' || digit > '9') return 0;
 
-  int hours = 0;
-  while (minutes > 59) {
-    ++hours;
-    minutes -= 60;
-    if (hours > 23) hours = 0;
+    number = number * 10 + (digit - '0');
   }
 
-  return (is_negative ? "-" : "")
-         + Numeric::ToString(hours, 2) + ":" + Numeric::ToString(minutes, 2);
+  return number;
+}
+
+// Write given amount of minutes formatted like "hh:mm" into given buffer,
+// hours have at least two digits. Digits are written backwards into a local
+// buffer, two at a time, from kDigitPairs
+size_t DateTime::FormatHoursFromMinutes(int minutes, char *buffer) {
+  char formatted[kMaxLenHoursFormatted];
+  char *end = formatted + kMaxLenHoursFormatted;
+  char *position = end;
+
+  // Widen before negating, to also handle INT_MIN
+  auto amount = static_cast<uint64_t>(
+      minutes < 0 ? -static_cast<int64_t>(minutes) : minutes);
+
+  uint64_t hours = amount / 60;
+
+  position -= 2;
+  std::memcpy(position, &kDigitPairs[2 * (amount % 60)], 2);
+  *--position = ':';
+
+  do {
+    position -= 2;
+    std::memcpy(position, &kDigitPairs[2 * (hours % 100)], 2);
+    hours /= 100;
+  } while (hours > 0);
+
+  // Remove zero-padding of odd amount of hour digits, except for "0h"
+  if ('0' == *position && end - position > 5) ++position;
+
+  if (minutes < 0) *--position = '-';
+
+  auto length = static_cast<size_t>(end - position);
+  std::memcpy(buffer, position, length);
+
+  return length;
+}
+
+// Format given amount of minutes like "hh:mm", see FormatHoursFromMinutes
+std::string DateTime::GetHoursFormattedFromMinutes(int minutes) {
+  char formatted[kMaxLenHoursFormatted];
+
+  return std::string(formatted, FormatHoursFromMinutes(minutes, formatted));
 }
 
 // Get index of day of week: sunday == 0, monday == 1, etc.
@@ -135,13 +173,11 @@ int DateTime::GetWeekdayIndexByDate(int year, int month, int day) {
       0, 0, 0,                       // second, minute, hour,
       day, month - 1, year - 1900};  // 1-based day, 0-based month, year > 1900
 
-  std::time_t time_temp = std::mktime(&time_in);
-
-  // Note: Return value of localtime is not thread-safe, because it might be
-  // (and will be) reused in subsequent calls to std::localtime!
-  const std::tm *time_out = std::localtime(&time_temp);
+  // mktime normalizes given struct, incl. day of week.
+  // Unlike the static result of localtime, this is thread-safe
+  std::mktime(&time_in);
 
-  return time_out->tm_wday;
+  return time_in.tm_wday;
 }
 
 // Get index of day of week from english name of weekday:
@@ -30,15 +30,33 @@
 #include <ttt/helper/helper_string.h>
 #include <ttt/helper/helper_numeric.h>
 
+#include <array>
+#include <cstdint>
 #include <ctime>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace helper::DateTime {
 
 const int kMinutesPerDay = 1440;
 
+// Max. length of minutes formatted by FormatHoursFromMinutes, e.g. of INT_MIN
+const size_t kMaxLenHoursFormatted = 16;
+
+// Two-digit decimal labels "00" to "99", concatenated
+constexpr std::array<char, 200> kDigitPairs = [] {
+  std::array<char, 200> pairs{};
+
+  for (int number = 0; number < 100; ++number) {
+    pairs[2 * number] = static_cast<char>('0' + number / 10);
+    pairs[2 * number + 1] = static_cast<char>('0' + number % 10);
+  }
+
+  return pairs;
+}();
+
 // Get string of current time, w/ given offset in days added, in given format
 extern std::string GetCurrentTimeFormatted(
     const char *format,
@@ -51,13 +69,21 @@ extern std::string ReformatDateAsYyyyMmDd(
     std::string date_first,
     std::string &source_format);
 
-// Calculate minutes since 0:00 from given formatted time label
+// Calculate minutes since 0:00 from given formatted time label.
+// A leading "-" (as in balances) negates the whole amount
 extern int GetSumMinutesFromTime(
-    std::string time_str = "",
-    const char *separator = ":");
+    std::string_view time_str = {},
+    char separator = ':');
+
+// Parse given unsigned decimal, w/o allocating. Anything else results in 0
+extern int ParseDigits(std::string_view digits);
+
+// Write given amount of minutes formatted like "hh:mm" into given buffer of
+// at least kMaxLenHoursFormatted chars, w/o allocating. Return the length.
+// Hours are not wrapped at 24, so balances of several days stay exact
+extern size_t FormatHoursFromMinutes(int minutes, char *buffer);
 
-// Format given amount of minutes like "hh:mm".
-// Hours >= 24 are treated as being in next day (begin from 0 again)
+// Format given amount of minutes like "hh:mm", see FormatHoursFromMinutes
 extern std::string GetHoursFormattedFromMinutes(int minutes);
 
 // Get index of day of week: sunday == 0, monday == 1, etc.
@@ -55,6 +55,79 @@ std::string File::GetFileContents(std::ifstream &file) {
   return str;
 }
 
+// Read whole file into given string, w/o stream overhead:
+// size is known from fstat, content is read straight into the string's buffer
+bool File::ReadFile(const std::string &filename, std::string *content) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) return false;
+
+  struct stat file_stat{};
+  if (fstat(fd, &file_stat) == -1) {
+    close(fd);
+
+    return false;
+  }
+
+  content->resize(static_cast<size_t>(file_stat.st_size));
+
+  size_t offset = 0;
+  while (offset < content->size()) {
+    ssize_t amount_read =
+        read(fd, &(*content)[offset], content->size() - offset);
+
+    if (amount_read <= 0) break;
+
+    offset += static_cast<size_t>(amount_read);
+  }
+
+  content->resize(offset);
+  close(fd);
+
+  return true;
+}
+
+bool File::ReadFileRange(
+    int fd,
+    size_t offset,
+    size_t length,
+    std::string *content) {
+  content->resize(length);
+
+  size_t amount_total = 0;
+  while (amount_total < length) {
+    ssize_t amount_read = pread(
+        fd,
+        &(*content)[amount_total],
+        length - amount_total,
+        static_cast<off_t>(offset + amount_total));
+
+    if (amount_read <= 0) break;
+
+    amount_total += static_cast<size_t>(amount_read);
+  }
+
+  content->resize(amount_total);
+
+  return amount_total == length;
+}
+
+bool File::WriteFileRange(int fd, size_t offset, const std::string &content) {
+  size_t amount_total = 0;
+  while (amount_total < content.size()) {
+    ssize_t amount_written = pwrite(
+        fd,
+        content.data() + amount_total,
+        content.size() - amount_total,
+        static_cast<off_t>(offset + amount_total));
+
+    if (amount_written <= 0) return false;
+
+    amount_total += static_cast<size_t>(amount_written);
+  }
+
+  return true;
+}
+
 bool File::WriteToNewFile(const std::string &filename, std::string &content) {
   std::ofstream outfile(filename);
   outfile << content;
@@ -67,4 +140,283 @@ bool File::Remove(const char *file_path) {
   return remove(file_path) == 0;
 }
 
+// Preserve content of given file at given new path: try copy-on-write
+// reflink, then hard link, then fall back to copying the bytes
+File::PreserveMethod File::PreserveFile(
+    const std::string &path_source,
+    const std::string &path_destination) {
+  remove(path_destination.c_str());
+
+  // Preserve the file a symlink points to, not the link itself
+  std::string path_real = GetRealPath(path_source);
+
+  if (ReflinkFile(path_real, path_destination)) return PreserveMethod_Reflink;
+
+  if (0 == link(path_real.c_str(), path_destination.c_str()))
+    return PreserveMethod_Link;
+
+  return CopyFile(path_real, path_destination)
+         ? PreserveMethod_Copy
+         : PreserveMethod_Failed;
+}
+
+bool File::ReflinkFile(
+    const std::string &path_source,
+    const std::string &path_destination) {
+#if defined(__APPLE__)
+  return 0 == clonefile(path_source.c_str(), path_destination.c_str(), 0);
+#elif defined(__linux__) && defined(FICLONE)
+  int fd_source = open(path_source.c_str(), O_RDONLY);
+  if (-1 == fd_source) return false;
+
+  int fd_destination =
+      open(path_destination.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+
+  if (-1 == fd_destination) {
+    close(fd_source);
+
+    return false;
+  }
+
+  bool result = 0 == ioctl(fd_destination, FICLONE, fd_source);
+
+  close(fd_source);
+  close(fd_destination);
+
+  if (!result) remove(path_destination.c_str());
+
+  return result;
+#else
+  return false;
+#endif
+}
+
+bool File::CopyFile(
+    const std::string &path_source,
+    const std::string &path_destination) {
+  std::string content;
+
+  if (!ReadFile(path_source, &content)) return false;
+
+  std::ofstream file(path_destination, std::ios::binary | std::ios::trunc);
+  file << content;
+
+  return static_cast<bool>(file);
+}
+
+// Write given content to a temporary file and rename it to given path,
+// so the file is replaced atomically and links to its old content are kept.
+// A symlinked path is written through: its target is replaced, keeping mode
+// and (where permitted) owner. The temporary file is named uniquely, as
+// sidecars are rebuilt by concurrent readers of the timesheet
+bool File::ReplaceFile(const std::string &path, const std::string &content) {
+  std::string path_real = GetRealPath(path);
+
+  std::string path_temporary = path_real + ".XXXXXX";
+
+  struct stat file_stat{};
+  bool exists = 0 == stat(path_real.c_str(), &file_stat);
+
+  int fd = mkstemp(path_temporary.data());
+
+  if (-1 == fd) return false;
+
+  bool result = WriteAll(fd, content)
+      && 0 == fchmod(fd, exists ? file_stat.st_mode & 07777 : 0644);
+
+  if (result && exists) {
+    if ((file_stat.st_uid != geteuid() || file_stat.st_gid != getegid())
+        && -1 == fchown(fd, file_stat.st_uid, file_stat.st_gid)) {
+      // Not permitted: replacement is owned by the current user
+    }
+  }
+
+  result = 0 == close(fd) && result;
+
+  if (!result) {
+    remove(path_temporary.c_str());
+
+    return false;
+  }
+
+  return 0 == rename(path_temporary.c_str(), path_real.c_str());
+}
+
+// Get canonical absolute path of given file, w/ symlinks resolved.
+// Given path if it cannot be resolved, e.g. when the file doesn't exist yet
+std::string File::GetRealPath(const std::string &path) {
+  char path_real[PATH_MAX];
+
+  return nullptr == realpath(path.c_str(), path_real)
+         ? path
+         : std::string(path_real);
+}
+
+// Write given content to given file descriptor, continuing partial writes
+bool File::WriteAll(int fd, const std::string &content) {
+  const char *data = content.data();
+  size_t length = content.size();
+
+  while (length > 0) {
+    ssize_t written = write(fd, data, length);
+
+    if (-1 == written) {
+      if (EINTR == errno) continue;
+
+      return false;
+    }
+
+    data += written;
+    length -= static_cast<size_t>(written);
+  }
+
+  return true;
+}
+
+// Get size and modification time (in nanoseconds) of given file
+bool File::GetSizeAndTimeModified(
+    const std::string &path,
+    uint64_t *size_file,
+    int64_t *time_modified) {
+  struct stat file_stat{};
+
+  if (-1 == stat(path.c_str(), &file_stat)) return false;
+
+  *size_file = static_cast<uint64_t>(file_stat.st_size);
+
+  // In nanoseconds: modifications can follow each other within a second
+#if defined(__APPLE__)
+  *time_modified =
+      static_cast<int64_t>(file_stat.st_mtimespec.tv_sec) * 1000000000
+      + file_stat.st_mtimespec.tv_nsec;
+#else
+  *time_modified = static_cast<int64_t>(file_stat.st_mtim.tv_sec) * 1000000000
+      + file_stat.st_mtim.tv_nsec;
+#endif
+
+  return true;
+}
+
+// Lock given file (created if missing), shared or exclusive, waiting up to
+// given milliseconds: < 0 = w/o limit, 0 = not at all
+int File::LockFile(const std::string &path, bool is_exclusive, int timeout_ms) {
+  int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+  // Shared locks need only read access, e.g. to a read-only directory
+  if (-1 == fd && !is_exclusive) fd = open(path.c_str(), O_RDONLY);
+
+  if (-1 == fd) return -1;
+
+  if (timeout_ms < 0) {
+    if (TryLockFile(fd, is_exclusive, true)) return fd;
+
+    close(fd);
+
+    return -1;
+  }
+
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+  // Poll w/ increasing delay: waiting locks cannot be given a timeout
+  int delay_ms = 1;
+
+  while (!TryLockFile(fd, is_exclusive, false)) {
+    auto remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+
+    if (remaining_ms <= 0
+        || (EAGAIN != errno && EACCES != errno && EWOULDBLOCK != errno)) {
+      close(fd);
+
+      return -1;
+    }
+
+    usleep(static_cast<useconds_t>(
+        1000 * std::min(static_cast<int64_t>(delay_ms), remaining_ms)));
+
+    delay_ms = std::min(delay_ms * 2, 50);
+  }
+
+  return fd;
+}
+
+bool File::TryLockFile(int fd, bool is_exclusive, bool wait) {
+  int result;
+
+  do {
+#if defined(F_OFD_SETLK)
+    // Zero start and length: lock the whole file
+    struct flock lock = {};
+    lock.l_type = is_exclusive ? F_WRLCK : F_RDLCK;
+    lock.l_whence = SEEK_SET;
+
+    result = fcntl(fd, wait ? F_OFD_SETLKW : F_OFD_SETLK, &lock);
+#else
+    result = flock(
+        fd, (is_exclusive ? LOCK_EX : LOCK_SH) | (wait ? 0 : LOCK_NB));
+#endif
+  } while (-1 == result && EINTR == errno);
+
+  return 0 == result;
+}
+
+void File::UnlockFile(int fd) {
+  if (-1 == fd) return;
+
+  // Closing the (only) descriptor of the open file description releases it
+  close(fd);
+}
+
+// Watch the directory of given file for modifications of files within it
+int File::WatchFile(const std::string &path) {
+#if defined(__linux__)
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (-1 == fd) return -1;
+
+  size_t offset_filename = path.rfind('/');
+
+  std::string path_directory = std::string::npos == offset_filename
+                               ? "."
+                               : path.substr(0, offset_filename + 1);
+
+  if (-1 == inotify_add_watch(
+      fd,
+      path_directory.c_str(),
+      IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO | IN_DELETE)) {
+    close(fd);
+
+    return -1;
+  }
+
+  return fd;
+#else
+  return -1;
+#endif
+}
+
+// Consume pending events of given watch descriptor,
+// returns whether any of them concerns the file of given name
+bool File::ReadWatchEvents(int fd, const std::string &filename) {
+  bool is_concerned = false;
+
+#if defined(__linux__)
+  alignas(struct inotify_event) char buffer[4096];
+
+  ssize_t length;
+
+  while ((length = read(fd, buffer, sizeof buffer)) > 0) {
+    for (char *event_position = buffer; event_position < buffer + length;) {
+      auto *event = reinterpret_cast<struct inotify_event *>(event_position);
+
+      if (event->len > 0 && filename == event->name) is_concerned = true;
+
+      event_position += sizeof(struct inotify_event) + event->len;
+    }
+  }
+#endif
+
+  return is_concerned;
+}
+
 }  // namespace helper
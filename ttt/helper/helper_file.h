@@ -27,8 +27,27 @@
 #ifndef TTT_HELPER_HELPER_FILE_H_
 #define TTT_HELPER_HELPER_FILE_H_
 
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#include <linux/fs.h>
+#include <sys/inotify.h>
+#elif defined(__APPLE__)
+#include <sys/clonefile.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
 #include <fstream>
 #include <string>
 #include <vector>
@@ -42,10 +61,87 @@ extern bool FileExists(const std::string &name);
 extern std::string GetFileContents(std::string &filename);
 extern std::string GetFileContents(std::ifstream &file);
 
+// Read whole file into given string, w/o stream overhead.
+// Returns false if the file does not exist / cannot be read
+extern bool ReadFile(const std::string &filename, std::string *content);
+
+// Read given byte range of open file into given string
+extern bool ReadFileRange(
+    int fd,
+    size_t offset,
+    size_t length,
+    std::string *content);
+
+// Write given content into open file, starting at given offset
+extern bool WriteFileRange(int fd, size_t offset, const std::string &content);
+
 extern bool WriteToNewFile(const std::string &filename, std::string &content);
 
 extern bool Remove(const char *file_path);
 
+// Ways of preserving a file's content under another path
+enum PreserveMethod {
+  PreserveMethod_Reflink,
+  PreserveMethod_Link,
+  PreserveMethod_Copy,
+  PreserveMethod_Failed
+};
+
+// Preserve content of given file at given new path, w/ the cheapest method
+// supported by the filesystem: copy-on-write reflink, hard link, byte copy.
+// A hard link shares the file: the original must afterwards only be replaced
+// (see ReplaceFile) but not be modified in place
+extern PreserveMethod PreserveFile(
+    const std::string &path_source,
+    const std::string &path_destination);
+
+// Clone given file via copy-on-write, where supported (btrfs, xfs, apfs)
+extern bool ReflinkFile(
+    const std::string &path_source,
+    const std::string &path_destination);
+
+extern bool CopyFile(
+    const std::string &path_source,
+    const std::string &path_destination);
+
+// Write given content to a uniquely named temporary file and rename it to
+// given path (or to the target of a symlink at that path), keeping mode and
+// owner
+extern bool ReplaceFile(const std::string &path, const std::string &content);
+
+// Get canonical absolute path of given file, w/ symlinks resolved
+extern std::string GetRealPath(const std::string &path);
+
+// Write given content to given file descriptor, continuing partial writes
+extern bool WriteAll(int fd, const std::string &content);
+
+// Get size and modification time (in nanoseconds) of given file
+extern bool GetSizeAndTimeModified(
+    const std::string &path,
+    uint64_t *size_file,
+    int64_t *time_modified);
+
+// Lock given file (created if missing), shared or exclusive, via an open file
+// description lock (flock where unavailable). Waits up to given milliseconds
+// for conflicting locks to be released: < 0 = w/o limit, 0 = not at all.
+// Returns the descriptor holding the lock, or -1
+extern int LockFile(const std::string &path, bool is_exclusive, int timeout_ms);
+
+// Try to lock given open file once, or wait w/o limit
+extern bool TryLockFile(int fd, bool is_exclusive, bool wait);
+
+// Release lock held by given descriptor, close it
+extern void UnlockFile(int fd);
+
+// Watch the directory of given file for modifications (via inotify), which
+// covers the file also when being replaced by rename. Returns a non-blocking
+// descriptor to poll() for events, -1 where unsupported
+extern int WatchFile(const std::string &path);
+
+// Consume pending events of given watch descriptor,
+// returns whether any of them concerns the file of given name
+extern bool ReadWatchEvents(int fd, const std::string &filename);
+
 }  // namespace helper::File
 
 #endif  // TTT_HELPER_HELPER_FILE_H_
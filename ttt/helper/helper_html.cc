@@ -28,497 +28,176 @@
 
 namespace helper {
 
-std::string Html::Encode(std::string str) {
-  std::string subs[] = {";", "&", "\"", "'", "<", ">", ":", "=", "!"};
-
-  std::string reps[] =
-      {"&semi;", "&amp;", "&quot;", "&apos;", "&lt;", "&gt;", "&colon;",
-       "&equals;", "&excl;"};
+namespace {
+struct Entity {
+  char32_t code_point;
+  const char *name;
+};
+
+// Characters encoded to named entities, sorted by code point
+const Entity kEntities[] = {
+    {0x0021, "excl"}, {0x0022, "quot"}, {0x0026, "amp"}, {0x0027, "apos"},
+    {0x003A, "colon"}, {0x003B, "semi"}, {0x003C, "lt"}, {0x003D, "equals"},
+    {0x003E, "gt"}, {0x00A1, "iexcl"}, {0x00A2, "cent"}, {0x00A3, "pound"},
+    {0x00A4, "curren"}, {0x00A5, "yen"}, {0x00A6, "brvbar"}, {0x00A7, "sect"},
+    {0x00A8, "uml"}, {0x00A9, "copy"}, {0x00AA, "ordf"}, {0x00AB, "laquo"},
+    {0x00AE, "reg"}, {0x00B0, "deg"}, {0x00B1, "plusmn"}, {0x00B2, "sup2"},
+    {0x00B3, "sup3"}, {0x00B6, "para"}, {0x00BB, "raquo"}, {0x00BC, "frac14"},
+    {0x00BD, "frac12"}, {0x00BE, "frac34"}, {0x00BF, "iquest"},
+    {0x00C0, "Agrave"}, {0x00C1, "Aacute"}, {0x00C2, "Acirc"},
+    {0x00C3, "Atilde"}, {0x00C4, "Auml"}, {0x00C5, "Aring"}, {0x00C6, "AElig"},
+    {0x00C7, "Ccedil"}, {0x00C8, "Egrave"}, {0x00C9, "Eacute"},
+    {0x00CA, "Ecirc"}, {0x00CB, "Euml"}, {0x00CC, "Igrave"},
+    {0x00CD, "Iacute"}, {0x00CE, "Icirc"}, {0x00CF, "Iuml"}, {0x00D0, "ETH"},
+    {0x00D1, "Ntilde"}, {0x00D2, "Ograve"}, {0x00D3, "Oacute"},
+    {0x00D4, "Ocirc"}, {0x00D5, "Otilde"}, {0x00D6, "Ouml"}, {0x00D7, "times"},
+    {0x00D8, "Oslash"}, {0x00D9, "Ugrave"}, {0x00DA, "Uacute"},
+    {0x00DB, "Ucirc"}, {0x00DC, "Uuml"}, {0x00DD, "Yacute"}, {0x00DE, "THORN"},
+    {0x00DF, "szlig"}, {0x00E0, "agrave"}, {0x00E1, "aacute"},
+    {0x00E2, "acirc"}, {0x00E3, "atilde"}, {0x00E4, "auml"}, {0x00E5, "aring"},
+    {0x00E6, "aelig"}, {0x00E7, "ccedil"}, {0x00E8, "egrave"},
+    {0x00E9, "eacute"}, {0x00EA, "ecirc"}, {0x00EB, "euml"},
+    {0x00EC, "igrave"}, {0x00ED, "iacute"}, {0x00EE, "icirc"},
+    {0x00EF, "iuml"}, {0x00F0, "eth"}, {0x00F1, "ntilde"}, {0x00F2, "ograve"},
+    {0x00F3, "oacute"}, {0x00F4, "ocirc"}, {0x00F5, "otilde"},
+    {0x00F6, "ouml"}, {0x00F7, "divide"}, {0x00F8, "oslash"},
+    {0x00F9, "ugrave"}, {0x00FA, "uacute"}, {0x00FB, "ucirc"},
+    {0x00FC, "uuml"}, {0x00FD, "yacute"}, {0x00FE, "thorn"}, {0x00FF, "yuml"},
+    {0x0152, "OElig"}, {0x0153, "oelig"}, {0x0160, "Scaron"},
+    {0x0161, "scaron"}, {0x0178, "Yuml"}, {0x02C6, "circ"}, {0x02DC, "tilde"},
+    {0x03A3, "Sigma"}, {0x03B1, "alpha"}, {0x03B2, "beta"}, {0x03B3, "gamma"},
+    {0x03B4, "delta"}, {0x03B5, "epsilon"}, {0x03B6, "zeta"}, {0x03B7, "eta"},
+    {0x03B8, "theta"}, {0x03B9, "iota"}, {0x03BA, "kappa"}, {0x03BB, "lambda"},
+    {0x03BC, "mu"}, {0x03BD, "nu"}, {0x03BE, "xi"}, {0x03BF, "omicron"},
+    {0x03C1, "rho"}, {0x03C2, "sigmaf"}, {0x03C3, "sigma"}, {0x03C4, "tau"},
+    {0x03C5, "upsilon"}, {0x2030, "permil"}, {0x2039, "lsaquo"},
+    {0x203A, "rsaquo"}, {0x20AC, "euro"}
+};
+
+// Bytes that can be copied as-is: all ASCII but the entity-encoded characters
+struct PlainBytes {
+  bool is_plain[256]{};
+
+  constexpr PlainBytes() {
+    for (int i = 0; i < 128; ++i) is_plain[i] = true;
+
+    for (char ch : {'!', '"', '&', '\'', ':', ';', '<', '=', '>'}) {
+      is_plain[static_cast<unsigned char>(ch)] = false;
+    }
+  }
+};
+
+constexpr PlainBytes kPlainBytes;
+
+// Decode UTF-8 sequence at given position, store its length.
+// Invalid sequences are reported as single byte w/o code point
+char32_t GetCodePoint(const unsigned char *bytes, size_t len, size_t *len_seq) {
+  *len_seq = 1;
+
+  unsigned char lead = bytes[0];
+  if (lead < 0x80) return lead;
+
+  size_t amount_continuation;
+  char32_t code_point;
+
+  if ((lead & 0xE0) == 0xC0) {
+    amount_continuation = 1;
+    code_point = lead & 0x1F;
+  } else if ((lead & 0xF0) == 0xE0) {
+    amount_continuation = 2;
+    code_point = lead & 0x0F;
+  } else if ((lead & 0xF8) == 0xF0) {
+    amount_continuation = 3;
+    code_point = lead & 0x07;
+  } else {
+    return 0;
+  }
 
-  int amount_entities = 9;
-  size_t found;
+  if (amount_continuation >= len) return 0;
 
-  for (int j = 0; j < amount_entities; j++) {
-    do {
-      found = str.find(subs[j]);
+  for (size_t i = 1; i <= amount_continuation; ++i) {
+    if ((bytes[i] & 0xC0) != 0x80) return 0;
 
-      if (std::string::npos != found) {
-        str.replace(found, subs[j].length(), reps[j]);
-      }
-    } while (std::string::npos != found);
+    code_point = (code_point << 6) | (bytes[i] & 0x3F);
   }
 
-  // Encode extended ascii characters
-  std::wstring wide_str = std::wstring(str.begin(), str.end());
-  auto str_len = static_cast<int>(wide_str.size());
-
-  for (int i = str_len; i >= 0; i--) {
-    char ch = str[i];
-    if (ch & 128) {
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "missing_default_case"
-      switch ((int) str[i - 1]) {
-        case -49:
-          switch ((int) str[i]) {
-            case -123:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&upsilon;");
-              break;
-            case -124:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&tau;");
-              break;
-            case -125:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&sigma;");
-              break;
-            case -126:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&sigmaf;");
-              break;
-            case -127:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&rho;");
-              break;
-          }
-          break;
-        case -50:
-          switch ((int) str[i]) {
-            case -65:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&omicron;");
-              break;
-            case -66:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&xi;");
-              break;
-            case -67:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&nu;");
-              break;
-            case -68:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&mu;");
-              break;
-            case -69:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&lambda;");
-              break;
-            case -70:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&kappa;");
-              break;
-            case -71:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&iota;");
-              break;
-            case -72:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&theta;");
-              break;
-            case -73:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&eta;");
-              break;
-            case -74:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&zeta;");
-              break;
-            case -75:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&epsilon;");
-              break;
-            case -76:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&delta;");
-              break;
-            case -77:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&gamma;");
-              break;
-            case -78:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&beta;");
-              break;
-            case -79:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&alpha;");
-              break;
-            case -93:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Sigma;");
-              break;
-          }
-          break;
-        case -53:
-          switch ((int) str[i]) {
-            case -100:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&tilde;");
-              break;
-            case -122:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&circ;");
-              break;
-          }
-          break;
-        case -59:
-          switch ((int) str[i]) {
-            case -72:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Yuml;");
-              break;
-            case -95:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&scaron;");
-              break;
-            case -96:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Scaron;");
-              break;
-            case -109:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&oelig;");
-              break;
-            case -110:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&OElig;");
-              break;
-          }
-          break;
-        case -61:
-          switch ((int) str[i]) {
-            case -65:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&yuml;");
-              break;
-            case -66:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&thorn;");
-              break;
-            case -67:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&yacute;");
-              break;
-            case -68:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&uuml;");
-              break;
-            case -69:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ucirc;");
-              break;
-            case -70:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&uacute;");
-              break;
-            case -71:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ugrave;");
-              break;
-            case -72:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&oslash;");
-              break;
-            case -73:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&divide;");
-              break;
-            case -74:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ouml;");
-              break;
-            case -75:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&otilde;");
-              break;
-            case -76:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ocirc;");
-              break;
-            case -77:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&oacute;");
-              break;
-            case -78:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ograve;");
-              break;
-            case -79:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ntilde;");
-              break;
-            case -80:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&eth;");
-              break;
-            case -81:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&iuml;");
-              break;
-            case -82:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&icirc;");
-              break;
-            case -83:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&iacute;");
-              break;
-            case -84:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&igrave;");
-              break;
-            case -85:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&euml;");
-              break;
-            case -86:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ecirc;");
-              break;
-            case -87:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&eacute;");
-              break;
-            case -88:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&egrave;");
-              break;
-            case -89:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ccedil;");
-              break;
-            case -90:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&aelig;");
-              break;
-            case -91:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&aring;");
-              break;
-            case -92:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&auml;");
-              break;
-            case -93:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&atilde;");
-              break;
-            case -94:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&acirc;");
-              break;
-            case -95:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&aacute;");
-              break;
-            case -96:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&agrave;");
-              break;
-            case -97:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&szlig;");
-              break;
-            case -99:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Yacute;");
-              break;
-            case -100:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Uuml;");
-              break;
-            case -101:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ucirc;");
-              break;
-            case -102:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Uacute;");
-              break;
-            case -103:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ugrave;");
-              break;
-            case -104:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Oslash;");
-              break;
-            case -105:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&times;");
-              break;
-            case -106:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ouml;");
-              break;
-            case -107:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Otilde;");
-              break;
-            case -108:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ocirc;");
-              break;
-            case -109:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Oacute;");
-              break;
-            case -110:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ograve;");
-              break;
-            case -111:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ntilde;");
-              break;
-            case -112:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ETH;");
-              break;
-            case -113:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Iuml;");
-              break;
-            case -114:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Icirc;");
-              break;
-            case -115:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Iacute;");
-              break;
-            case -116:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Igrave;");
-              break;
-            case -117:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Euml;");
-              break;
-            case -118:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ecirc;");
-              break;
-            case -119:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Eacute;");
-              break;
-            case -120:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Egrave;");
-              break;
-            case -121:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Ccedil;");
-              break;
-            case -122:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Aelig;");
-              break;
-            case -123:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Aring;");
-              break;
-            case -124:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Auml;");
-              break;
-            case -125:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Atilde;");
-              break;
-            case -126:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Acirc;");
-              break;
-            case -127:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Acute;");
-              break;
-            case -128:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&Agrave;");
-              break;
-          }
-          break;
-        case -62:
-          switch ((int) str[i]) {
-            case -65:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&iquest;");
-              break;
-            case -66:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&frac34;");
-              break;
-            case -67:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&frac12;");
-              break;
-            case -68:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&frac14;");
-              break;
-            case -69:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&raquo;");
-              break;
-            case -74:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&para;");
-              break;
-            case -77:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&sup3;");
-              break;
-            case -78:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&sup2;");
-              break;
-            case -79:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&plusmn;");
-              break;
-            case -80:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&deg;");
-              break;
-            case -82:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&reg;");
-              break;
-            case -85:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&laquo;");
-              break;
-            case -86:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&ordf;");
-              break;
-            case -87:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&copy;");
-              break;
-            case -88:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&uml;");
-              break;
-            case -89:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&sect;");
-              break;
-            case -90:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&brvbar;");
-              break;
-            case -91:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&yen;");
-              break;
-            case -92:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&curren;");
-              break;
-            case -93:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&pound;");
-              break;
-            case -94:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&cent;");
-              break;
-            case -95:wide_str =
-                ReplaceWideCharByEntity(wide_str, str_len, i, L"&iexcl;");
-              break;
-          }
-          break;
-        case -126:
-          switch ((int) str[i]) {
-            case -84:
-              if ((int) str[i - 2] == -30)
-                wide_str = ReplaceWideCharByEntity(
-                    wide_str,
-                    str_len,
-                    i,
-                    i - 2,
-                    i + 1,
-                    L"&euro;");
-              break;
-          }
-          break;
-        case -129:
-          switch ((int) str[i]) {
-            case -71:
-              switch ((int) str[i - 2]) {
-                case -29:wide_str =
-                    ReplaceWideCharByEntity(
-                        wide_str,
-                        str_len,
-                        i,
-                        i - 2,
-                        i + 1,
-                        L"&rsaquo;");
-                  break;
-                case -30:wide_str = ReplaceWideCharByEntity(
-                    wide_str,
-                    str_len,
-                    i,
-                    i - 2,
-                    i + 1,
-                    L"&lsaquo;");
-                  break;
-              }
-              break;
-            case -80:
-              if ((int) str[i - 2] == -30)
-                wide_str = ReplaceWideCharByEntity(
-                    wide_str,
-                    str_len,
-                    i,
-                    i - 2,
-                    i + 1,
-                    L"&permil;");
-              break;
-          }
-          break;
-      }
-#pragma clang diagnostic pop
-    }
-//}
-  }
-  str = std::string(wide_str.begin(), wide_str.end());
+  *len_seq = amount_continuation + 1;
 
-  return str;
+  return code_point;
 }
 
-std::wstring Html::ReplaceWideCharByEntity(
-    const std::wstring& wstr,
-    int str_len,
-    int offset,
-    int offset_left,
-    int offset_right,
-    const std::wstring& replacement) {
-  return offset < str_len
-         ? wstr.substr(0, offset_left)
-           + replacement
-           + wstr.substr(offset_right, std::string::npos)
-         : wstr.substr(0, offset_left) + replacement;
+const char *GetEntityName(char32_t code_point) {
+  const Entity *end = kEntities + sizeof kEntities / sizeof *kEntities;
+
+  const Entity *entity = std::lower_bound(
+      kEntities, end, code_point,
+      [](const Entity &item, char32_t value) {
+        return item.code_point < value;
+      });
+
+  return entity != end && entity->code_point == code_point
+         ? entity->name
+         : nullptr;
 }
+}  // namespace
+
+std::string Html::Encode(const std::string &str) {
+  std::string encoded;
+  Encode(str, &encoded);
 
-std::wstring Html::ReplaceWideCharByEntity(
-    const std::wstring& wstr,
-    int str_len,
-    int offset,
-    const std::wstring& replacement) {
-  return ReplaceWideCharByEntity(
-      wstr,
-      str_len,
-      offset,
-      offset - 1,
-      offset + 1,
-      replacement);
+  return encoded;
 }
 
-std::string Html::Decode(const std::string& str) {
-  auto *dest = new char[str.length() + 1];
+// Single pass: runs of plain bytes are copied in bulk,
+// characters w/ a known entity are looked-up in the sorted entity table
+void Html::Encode(const std::string &str, std::string *out) {
+  out->clear();
+  out->reserve(str.size() + str.size() / 4);
+
+  const auto *bytes = reinterpret_cast<const unsigned char *>(str.data());
+  size_t len = str.size();
+  size_t offset_run = 0;
+
+  for (size_t i = 0; i < len;) {
+    if (kPlainBytes.is_plain[bytes[i]]) {
+      ++i;
+      continue;
+    }
 
-  strcpy(dest, str.c_str());
-  decode_html_entities_utf8(dest, nullptr);
+    size_t len_seq;
+    char32_t code_point = GetCodePoint(bytes + i, len - i, &len_seq);
+
+    const char *entity = 0 == code_point ? nullptr : GetEntityName(code_point);
+
+    if (nullptr != entity) {
+      out->append(str, offset_run, i - offset_run);
+      out->push_back('&');
+      out->append(entity);
+      out->push_back(';');
+
+      offset_run = i + len_seq;
+    }
+
+    i += len_seq;
+  }
+
+  out->append(str, offset_run, len - offset_run);
+}
+
+std::string Html::Decode(const std::string &str) {
+  std::string decoded;
+  Decode(str, &decoded);
+
+  return decoded;
+}
 
-  auto result = std::string(dest);
+// Decode in-place within output buffer, strings w/o "&" are copied as-is
+void Html::Decode(const std::string &str, std::string *out) {
+  out->assign(str);
 
-  delete[] dest;
+  if (nullptr == std::memchr(str.data(), '&', str.size())) return;
 
-  return result;
+  out->resize(decode_html_entities_utf8(&(*out)[0], nullptr));
 }
 
 }  // namespace helper
@@ -29,23 +29,22 @@
 
 #include <vendor/entities/decode_html_entities_utf8.h>
 
+#include <algorithm>
 #include <cstring>
 #include <utility>
 #include <string>
 
 namespace helper::Html {
 
-extern std::string Encode(std::string str);
+// Encode special ASCII- and known multi-byte UTF-8 characters to named entities
+extern std::string Encode(const std::string &str);
+// Encode into given (reusable) output buffer
+extern void Encode(const std::string &str, std::string *out);
 
-extern std::wstring ReplaceWideCharByEntity(
-    const std::wstring& wstr, int str_len,
-    int offset, int offset_left, int offset_right,
-    const std::wstring& replacement);
-
-extern std::wstring ReplaceWideCharByEntity(
-    const std::wstring& wstr, int str_len, int offset, const std::wstring& replacement);
-
-extern std::string Decode(const std::string& str);
+// Decode HTML entities to UTF-8
+extern std::string Decode(const std::string &str);
+// Decode into given (reusable) output buffer
+extern void Decode(const std::string &str, std::string *out);
 
 }  // namespace helper::Html
 
@@ -26,6 +26,10 @@
 
 #include <ttt/helper/helper_string.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace helper {
 
 // Check whether given string starts w/ given prefix
@@ -63,39 +67,206 @@ bool String::Contains(char *haystack, const char *needle) {
     std::string::npos != std::string(haystack, strlen(haystack)).find(needle);
 }
 
-// Get UTF-8 string length
+// Get UTF-8 string length: amount of code points
 // (special chars like umlauts would otherwise be two bytes, not one)
 int String::GetUtf8Size(const std::string& str) {
-  std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+  int amount_code_points = 0;
+
+  // Count all bytes but continuation bytes (10xxxxxx)
+  for (unsigned char ch : str) {
+    if ((ch & 0xC0) != 0x80) ++amount_code_points;
+  }
+
+  return amount_code_points;
+}
+
+// Get amount of terminal columns needed to display given UTF-8 string
+int String::GetDisplayWidth(const std::string &str) {
+  return GetDisplayWidth(str.data(), str.size(), nullptr, -1);
+}
+
+// Get display width of given UTF-8 string, optionally stop at a maximum width
+// and store the byte length of the (prefix of the) string within that width.
+// Runs of ASCII are consumed 8 bytes per step
+int String::GetDisplayWidth(
+    const char *str, size_t len, size_t *len_within, int max_width) {
+  const auto *bytes = reinterpret_cast<const unsigned char *>(str);
+  size_t offset = 0;
+  int width = 0;
+
+  while (offset < len) {
+    if (max_width == -1 || width + 8 <= max_width) {
+      uint64_t word;
+
+      while (offset + 8 <= len
+          && (max_width == -1 || width + 8 <= max_width)) {
+        memcpy(&word, bytes + offset, 8);
+
+        if ((word & 0x8080808080808080ull) != 0) break;
+
+        offset += 8;
+        width += 8;
+      }
+    }
+
+    if (offset >= len) break;
+
+    size_t len_seq;
+    int width_char = GetCodePointWidth(bytes + offset, len - offset, &len_seq);
+
+    if (max_width != -1 && width + width_char > max_width) break;
+
+    width += width_char;
+    offset += len_seq;
+  }
+
+  if (len_within != nullptr) *len_within = offset;
+
+  return width;
+}
+
+// Get display width of UTF-8 sequence at given position, store its length:
+// 0 for combining marks / zero-width characters,
+// 2 for East Asian wide and fullwidth characters (CJK, Hangul, emoji), else 1
+int String::GetCodePointWidth(
+    const unsigned char *bytes, size_t len, size_t *len_seq) {
+  *len_seq = 1;
+
+  unsigned char lead = bytes[0];
+  if (lead < 0x80) return 1;
+
+  size_t amount_continuation;
+  uint32_t cp;
+
+  if ((lead & 0xE0) == 0xC0) {
+    amount_continuation = 1;
+    cp = lead & 0x1Fu;
+  } else if ((lead & 0xF0) == 0xE0) {
+    amount_continuation = 2;
+    cp = lead & 0x0Fu;
+  } else if ((lead & 0xF8) == 0xF0) {
+    amount_continuation = 3;
+    cp = lead & 0x07u;
+  } else {
+    // Invalid lead byte
+    return 1;
+  }
 
-  /*std::wstring wide =*/ converter.from_bytes(str);
+  if (amount_continuation >= len) return 1;
 
-  return static_cast<int>(std::strlen(str.c_str()));
+  for (size_t i = 1; i <= amount_continuation; ++i) {
+    if ((bytes[i] & 0xC0) != 0x80) return 1;
+
+    cp = (cp << 6) | (bytes[i] & 0x3Fu);
+  }
+
+  *len_seq = amount_continuation + 1;
+
+  if ((cp >= 0x0300 && cp <= 0x036F)
+      || (cp >= 0x1AB0 && cp <= 0x1AFF)
+      || (cp >= 0x1DC0 && cp <= 0x1DFF)
+      || (cp >= 0x200B && cp <= 0x200F)
+      || (cp >= 0x20D0 && cp <= 0x20FF)
+      || (cp >= 0xFE00 && cp <= 0xFE0F)
+      || (cp >= 0xFE20 && cp <= 0xFE2F)) {
+    return 0;
+  }
+
+  if ((cp >= 0x1100 && cp <= 0x115F)
+      || (cp >= 0x2E80 && cp <= 0x303E)
+      || (cp >= 0x3041 && cp <= 0x33FF)
+      || (cp >= 0x3400 && cp <= 0x4DBF)
+      || (cp >= 0x4E00 && cp <= 0x9FFF)
+      || (cp >= 0xA000 && cp <= 0xA4CF)
+      || (cp >= 0xAC00 && cp <= 0xD7A3)
+      || (cp >= 0xF900 && cp <= 0xFAFF)
+      || (cp >= 0xFE30 && cp <= 0xFE4F)
+      || (cp >= 0xFF00 && cp <= 0xFF60)
+      || (cp >= 0xFFE0 && cp <= 0xFFE6)
+      || (cp >= 0x1F300 && cp <= 0x1F64F)
+      || (cp >= 0x1F900 && cp <= 0x1F9FF)
+      || (cp >= 0x20000 && cp <= 0x3FFFD)) {
+    return 2;
+  }
+
+  return 1;
 }
 
 // Get amount of sub string occurrences
 int String::GetSubStrCount(const char *str, const char *sub) {
-  auto length = static_cast<int>(strlen(sub));
+  return GetSubStrCount(str, strlen(str), sub);
+}
+
+int String::GetSubStrCount(const std::string &str, const char *sub) {
+  return GetSubStrCount(str.data(), str.size(), sub);
+}
 
-  if (length == 0) {
+// Count non-overlapping occurrences, w/o needing strlen of the haystack.
+// With SSE2: test 16 offsets at once for matching 1st and last character of
+// the sub string, only candidates passing both are verified w/ memcmp
+int String::GetSubStrCount(const char *str, size_t len, const char *sub) {
+  size_t len_sub = strlen(sub);
+
+  if (len_sub == 0 || len_sub > len) {
     return 0;
   }
 
   int count = 0;
+  // Offset from where on the next match may start (matches do not overlap)
+  size_t offset_min = 0;
+  size_t offset = 0;
+
+#ifdef __SSE2__
+  const __m128i first = _mm_set1_epi8(sub[0]);
+  const __m128i last = _mm_set1_epi8(sub[len_sub - 1]);
+
+  for (; offset + len_sub - 1 + 16 <= len; offset += 16) {
+    __m128i block_first = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(str + offset));
+    __m128i block_last = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(str + offset + len_sub - 1));
+
+    auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, block_first),
+        _mm_cmpeq_epi8(last, block_last))));
+
+    while (mask != 0) {
+      size_t offset_candidate = offset + __builtin_ctz(mask);
+      mask &= mask - 1;
+
+      if (offset_candidate >= offset_min
+          && 0 == memcmp(str + offset_candidate, sub, len_sub)) {
+        ++count;
+        offset_min = offset_candidate + len_sub;
+      }
+    }
+  }
+#endif
+
+  offset = std::max(offset, offset_min);
 
-  for (str = strstr(str, sub); str; str = strstr(str + length, sub)) {
-    ++count;
+  for (; offset + len_sub <= len; ++offset) {
+    if (str[offset] == sub[0] && 0 == memcmp(str + offset, sub, len_sub)) {
+      ++count;
+      offset += len_sub - 1;
+    }
   }
 
   return count;
 }
 
+// Truncate given string to fit into given display width, w/ trailing "..."
 extern void String::Ellipsis(std::string &str, unsigned int max_length) {
-  if (str.length() < max_length) {
+  if (GetDisplayWidth(str) < static_cast<int>(max_length)) {
     return;
   }
 
-  str = str.substr(0, static_cast<unsigned long>(max_length - 4)) + "...";
+  size_t len_within;
+
+  GetDisplayWidth(
+      str.data(), str.size(), &len_within, static_cast<int>(max_length) - 4);
+
+  str = str.substr(0, len_within) + "...";
 }
 
 // Replace all needle occurrences in haystack
@@ -108,28 +279,124 @@ std::string String::ReplaceAll(
   return ReplaceAll(str, needle, replacement);
 }
 
+// Replace all needle occurrences in haystack, building the result in a new
+// buffer (linear instead of shifting the tail per match).
+// Inserted replacements are re-scanned together w/ the following text,
+// so e.g. "\n\n" -> "\n" collapses whole runs. A needle lying fully within a
+// replacement is not replaced again (avoids endless loops, e.g. "a" -> "aa")
 std::string String::ReplaceAll(
     std::string &haystack,
     const char *needle,
     const char *replacement) {
   size_t needle_len = strlen(needle);
 
-  size_t index = 0;
+  if (needle_len == 0) return haystack;
 
-  while (true) {
-    index = haystack.find(needle, index);
+  size_t replacement_len = strlen(replacement);
 
-    if (std::string::npos == index) {
-      break;
-    }
+  std::string result;
+  result.reserve(haystack.size());
+
+  size_t offset = 0;
+  size_t index;
+
+  while (std::string::npos != (index = haystack.find(needle, offset))) {
+    result.append(haystack, offset, index - offset);
+    offset = index + needle_len;
+
+    // Append replacement, re-check matches starting within it
+    size_t offset_replacement = result.size();
+    result.append(replacement, replacement_len);
 
-    haystack.replace(index, needle_len, replacement);
+    size_t offset_candidate = offset_replacement;
+
+    while (offset_candidate < result.size()) {
+      size_t len_in_result = result.size() - offset_candidate;
+
+      if (len_in_result < needle_len
+          && 0 == result.compare(
+              offset_candidate, len_in_result, needle, len_in_result)
+          && 0 == haystack.compare(
+              offset,
+              needle_len - len_in_result,
+              needle + len_in_result,
+              needle_len - len_in_result)) {
+        // Match spans end of replacement and following text: replace it
+        result.resize(offset_candidate);
+        offset += needle_len - len_in_result;
+
+        offset_replacement = offset_candidate;
+        result.append(replacement, replacement_len);
+
+        offset_candidate = offset_replacement;
+        continue;
+      }
+
+      ++offset_candidate;
+    }
   }
 
-  // TODO(kay): ensure avoid endless looping (when e.g. replacing "a" by "aa")
+  result.append(haystack, offset, std::string::npos);
+
+  haystack = std::move(result);
+
   return haystack;
 }
 
+// Replace occurrences of multiple needles in a single pass.
+// At each offset the 1st matching needle (in given order) is replaced
+std::string String::ReplaceAll(
+    const std::string &haystack,
+    const std::vector<std::pair<const char *, const char *>> &replacements) {
+  bool is_first_char[256] = {};
+  std::vector<size_t> needle_lengths;
+
+  for (auto const &replacement : replacements) {
+    is_first_char[static_cast<unsigned char>(replacement.first[0])] = true;
+    needle_lengths.push_back(strlen(replacement.first));
+  }
+
+  std::string result;
+  result.reserve(haystack.size());
+
+  size_t len = haystack.size();
+  size_t offset_run = 0;
+
+  for (size_t offset = 0; offset < len;) {
+    if (!is_first_char[static_cast<unsigned char>(haystack[offset])]) {
+      ++offset;
+      continue;
+    }
+
+    size_t index_match = 0;
+
+    for (; index_match < replacements.size(); ++index_match) {
+      if (needle_lengths[index_match] > 0
+          && 0 == haystack.compare(
+              offset,
+              needle_lengths[index_match],
+              replacements[index_match].first)) {
+        break;
+      }
+    }
+
+    if (index_match == replacements.size()) {
+      ++offset;
+      continue;
+    }
+
+    result.append(haystack, offset_run, offset - offset_run);
+    result.append(replacements[index_match].second);
+
+    offset += needle_lengths[index_match];
+    offset_run = offset;
+  }
+
+  result.append(haystack, offset_run, std::string::npos);
+
+  return result;
+}
+
 void String::ReplaceAllByReference(
     std::string &str,
     const char *needle,
@@ -160,6 +427,36 @@ std::string String::CsvEncode(std::string str) {
   return str;
 }
 
+// Append given text to given output, escaped as JSON string content
+void String::JsonEncode(std::string_view str, std::string *out) {
+  static const char kHexDigits[] = "0123456789abcdef";
+
+  size_t offset_plain = 0;
+
+  for (size_t offset = 0; offset < str.size(); ++offset) {
+    auto byte = static_cast<unsigned char>(str[offset]);
+
+    if (byte >= 0x20 && '"' != byte && '\\' != byte) continue;
+
+    out->append(str.data() + offset_plain, offset - offset_plain);
+    offset_plain = offset + 1;
+
+    switch (byte) {
+      case '"': out->append("\\\""); break;
+      case '\\': out->append("\\\\"); break;
+      case '\n': out->append("\\n"); break;
+      case '\r': out->append("\\r"); break;
+      case '\t': out->append("\\t"); break;
+      default:
+        out->append("\\u00")
+            .append(1, kHexDigits[byte >> 4])
+            .append(1, kHexDigits[byte & 0xF]);
+    }
+  }
+
+  out->append(str.data() + offset_plain, str.size() - offset_plain);
+}
+
 //  Get sub string inbetween given surrounding
 //  left- and right-hand-side delimiters
 std::string String::GetSubStrBetween(
@@ -225,101 +522,10 @@ int String::ToInt(const std::string& str, int defaultValue) {
          : defaultValue;
 }
 
-// Get amount characters in given string,
-// counting wide-ascii characters as 1 character (not 2 or 3)
-int String::GetAmountChars(std::string str) {
-  // Reduce extended ascii characters to 1 character: a
-  std::wstring wide_str = std::wstring(str.begin(), str.end());
-
-  auto str_len = static_cast<int>(wide_str.size());
-
-  for (int i = str_len; i >= 0; i--) {
-    char ch = str[i];
-
-    if (ch & 128) {
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "missing_default_case"
-      switch ((int) str[i - 1]) {
-        case -49:
-          if ((int) str[i] >= -127 && (int) str[i] <= -123) {
-            wide_str = ReduceWideChar(wide_str, str_len, i);
-          }
-          break;
-        case -50:
-          if ((int) str[i] >= -93 && (int) str[i] <= -65) {
-            wide_str = ReduceWideChar(wide_str, str_len, i);
-          }
-          break;
-        case -53:
-          if ((int) str[i] >= -122 && (int) str[i] <= -100) {
-            wide_str = ReduceWideChar(wide_str, str_len, i);
-          }
-          break;
-        case -59:
-          if ((int) str[i] >= -110 && (int) str[i] <= -72) {
-            wide_str = ReduceWideChar(wide_str, str_len, i);
-          }
-          break;
-        case -61:
-          if ((int) str[i] >= -128 && (int) str[i] <= -65) {
-            wide_str = ReduceWideChar(wide_str, str_len, i);
-          }
-          break;
-        case -62:
-          if ((int) str[i] >= -95 && (int) str[i] <= -65) {
-            wide_str = ReduceWideChar(wide_str, str_len, i);
-          }
-          break;
-        case -126:
-          switch ((int) str[i]) {
-            case -84:
-              if ((int) str[i - 2] == -30) {
-                wide_str = ReduceWideChar(wide_str, str_len, i, i - 2, i + 1);
-              }
-              break;
-          }
-          break;
-        case -129:
-          switch ((int) str[i]) {
-            case -71:
-              if ((int) str[i - 2] >= -30 && (int) str[i - 2] <= -29) {
-                wide_str = ReduceWideChar(wide_str, str_len, i, i - 2, i + 1);
-              }
-              break;
-            case -80:
-              if ((int) str[i - 2] == -30) {
-                wide_str = ReduceWideChar(wide_str, str_len, i, i - 2, i + 1);
-              }
-              break;
-          }
-          break;
-      }
-#pragma clang diagnostic pop
-    }
-  }
-
-  str = std::string(wide_str.begin(), wide_str.end());
-
-  return static_cast<int>(str.size());
-}
-
-std::wstring String::ReduceWideChar(const std::wstring& wstr,
-                                    int str_len,
-                                    int offset,
-                                    int offset_left,
-                                    int offset_right) {
-  return offset < str_len
-         ? wstr.substr(0, offset_left)
-            + L"X"
-            + wstr.substr(offset_right, std::string::npos)
-         : wstr.substr(0, offset_left) + L"x";
-}
-
-std::wstring String::ReduceWideChar(
-    const std::wstring& wstr,
-    int str_len,
-    int offset) {
-  return ReduceWideChar(wstr, str_len, offset, offset - 1, offset + 1);
+// Get amount characters in given string, as displayed in terminal columns
+// (umlauts etc. count as 1, CJK as 2 characters)
+int String::GetAmountChars(const std::string &str) {
+  return GetDisplayWidth(str);
 }
 
 // Trim from start (in place)
@@ -329,7 +535,7 @@ void String::LTrim(std::string &s) {
       std::find_if(
           s.begin(),
           s.end(),
-          std::not1(std::ptr_fun<int, int>(std::isspace))));
+          [](unsigned char ch) { return !std::isspace(ch); }));
 }
 
 // Trim from end (in place)
@@ -338,7 +544,7 @@ void String::RTrim(std::string &s) {
       std::find_if(
           s.rbegin(),
           s.rend(),
-          std::not1(std::ptr_fun<int, int>(std::isspace))).base(),
+          [](unsigned char ch) { return !std::isspace(ch); }).base(),
       s.end());
 }
 
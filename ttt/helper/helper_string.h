@@ -28,12 +28,11 @@
 #define TTT_HELPER_HELPER_STRING_H_
 
 #include <algorithm>
-#include <codecvt>
+#include <cstdint>
 #include <cstring>
-#include <functional>
-#include <locale>
 #include <string>
 #include <sstream>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -57,8 +56,21 @@ extern bool Contains(char *haystack, const char *needle);
 // (special chars like umlauts would otherwise be two bytes, not one)
 extern int GetUtf8Size(const std::string& str);
 
+// Get amount of terminal columns needed to display given UTF-8 string
+extern int GetDisplayWidth(const std::string &str);
+// Get display width, stop at max. width (-1 = unlimited),
+// optionally store amount of bytes within that width
+extern int GetDisplayWidth(
+    const char *str, size_t len, size_t *len_within, int max_width);
+
+// Get display width (0, 1 or 2) of UTF-8 sequence at given position
+extern int GetCodePointWidth(
+    const unsigned char *bytes, size_t len, size_t *len_seq);
+
 // Get amount of sub string occurrences
 extern int GetSubStrCount(const char *str, const char *sub);
+extern int GetSubStrCount(const std::string &str, const char *sub);
+extern int GetSubStrCount(const char *str, size_t len, const char *sub);
 
 extern void Ellipsis(std::string &content, unsigned int length);
 
@@ -73,6 +85,11 @@ extern std::string ReplaceAll(
     const char *needle,
     const char *replacement);
 
+// Replace all occurrences of multiple needles in a single pass
+extern std::string ReplaceAll(
+    const std::string &haystack,
+    const std::vector<std::pair<const char *, const char *>> &replacements);
+
 extern void ReplaceAllByReference(
     std::string &str,
     const char *from,
@@ -80,6 +97,9 @@ extern void ReplaceAllByReference(
 
 extern std::string CsvEncode(std::string str);
 
+// Append given (UTF-8) text to given output, escaped as JSON string content
+extern void JsonEncode(std::string_view str, std::string *out);
+
 // Get sub string between given surrounding left- and right-hand-side delimiters
 extern std::string GetSubStrBetween(
     const std::string &str,
@@ -94,20 +114,9 @@ extern bool IsNumeric(const std::string &str);
 extern int ToInt(const char *str, int defaultValue = 0);
 extern int ToInt(const std::string& str, int defaultValue = 0);
 
-// Get amount characters in given string,
-// counting wide-ascii characters as 1 character (not 2 or 3)
-extern int GetAmountChars(std::string str);
-extern std::wstring ReduceWideChar(
-    const std::wstring& wstr,
-    int str_len,
-    int offset,
-    int offset_left,
-    int offset_right);
-
-extern std::wstring ReduceWideChar(
-    const std::wstring& wstr,
-    int str_len,
-    int offset);
+// Get amount characters in given string, as displayed in terminal columns
+// (umlauts etc. count as 1, CJK as 2 characters)
+extern int GetAmountChars(const std::string &str);
 
 extern void LTrim(std::string &s);
 extern void RTrim(std::string &s);
@@ -31,6 +31,9 @@
   #include <sys/ttycom.h>
 #endif
 
+// Environment of current process, passed-on to spawned processes
+extern char **environ;
+
 namespace helper {
 
 // Get absolute path to application executable
@@ -41,8 +44,10 @@ std::string System::GetBinaryPath(char **argv, size_t strLenExecutableName) {
 
   ptr = realpath(path_relative, absolute_path);
 
-  unsigned long len_without_binary =
-      std::strlen(absolute_path) - strLenExecutableName;
+  // Executable not found (e.g. when embedded via libttt): path as given
+  if (nullptr == ptr) ptr = path_relative;
+
+  unsigned long len_without_binary = std::strlen(ptr) - strLenExecutableName;
 
   return std::string(ptr).substr(0, len_without_binary);
 }
@@ -59,6 +64,15 @@ int System::GetMaxCharsPerTerminalRow() {
   return w.ws_col;
 }
 
+// @return Amount of lines in current terminal
+int System::GetAmountTerminalRows() {
+  struct winsize w{};
+
+  ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+
+  return w.ws_row;
+}
+
 // Get language key from system default locale
 std::string System::GetLanguageKey() {
   setlocale(LC_ALL, "");
@@ -66,20 +80,43 @@ std::string System::GetLanguageKey() {
   return String::Explode(setlocale(LC_ALL, nullptr), '_')[0];
 }
 
-// Wait for keys being pressed: y / Y / n / N / ENTER. CTRL+c aborts
-bool System::GetYesOrNoKeyPress() {
-  // Suppress echo, go to RAW mode
-  system("stty -echo");
-  system("stty cbreak");
+// Launch given command w/ arguments, w/o invoking a shell and w/o waiting
+// for it to finish. Executable is looked-up in PATH
+bool System::Spawn(const std::vector<std::string> &arguments) {
+  if (arguments.empty()) return false;
+
+  std::vector<char *> argv;
+  argv.reserve(arguments.size() + 1);
 
-  int ch = getchar();
-  while (10 != ch && 78 != ch && 89 != ch && 110 != ch && 121 != ch) {
-    ch = getchar();
+  for (auto const &argument : arguments) {
+    argv.push_back(const_cast<char *>(argument.c_str()));
   }
 
-  // Make echo work, go to COOKED mode
-  system("stty echo");
-  system("stty -cbreak");
+  argv.push_back(nullptr);
+
+  pid_t pid;
+
+  return 0 == posix_spawnp(
+      &pid, argv[0], nullptr, nullptr, argv.data(), environ);
+}
+
+// Wait for any of given keys being pressed, EOF on stdin counts as ENTER
+int System::WaitForKeyPress(const char *keys) {
+  bool is_cbreak = Tui::EnterCbreakMode();
+
+  int ch = Tui::ReadKey();
+  while (-1 != ch && (0 == ch || nullptr == std::strchr(keys, ch))) {
+    ch = Tui::ReadKey();
+  }
+
+  if (is_cbreak) Tui::RestoreTerminalMode();
+
+  return -1 == ch ? 10 : ch;
+}
+
+// Wait for keys being pressed: y / Y / n / N / ENTER. CTRL+c aborts
+bool System::GetYesOrNoKeyPress() {
+  int ch = WaitForKeyPress("\nNYny");
 
   // Everything but "n" / "N" means yes
   return ch != 78 && ch != 110;
@@ -87,18 +124,7 @@ bool System::GetYesOrNoKeyPress() {
 
 // Wait for keys being pressed: y / Y / n / N / ENTER. CTRL+c aborts
 bool System::GetNoOrYesKeyPress() {
-  // Suppress echo, go to RAW mode
-  system("stty -echo");
-  system("stty cbreak");
-
-  int ch = getchar();
-  while (10 != ch && 78 != ch && 89 != ch && 110 != ch && 121 != ch) {
-    ch = getchar();
-  }
-
-  // Make echo work, go to COOKED mode
-  system("stty echo");
-  system("stty -cbreak");
+  int ch = WaitForKeyPress("\nNYny");
 
   // Everything but "y" / "Y" means no
   return ch == 89 || ch == 121;
@@ -106,19 +132,37 @@ bool System::GetNoOrYesKeyPress() {
 
 // Wait for key-press: ENTER. CTRL+c aborts
 void System::WaitForEnterKeyPress() {
-  // Suppress echo, go to RAW mode
-  system("stty -echo");
-  system("stty cbreak");
+  WaitForKeyPress("\n");
+}
+
+// Invoke given function on consecutive sub-ranges of [0, amount),
+// on up to one thread per core, w/ at least given amount of items each
+void System::ForEachInRange(
+    size_t amount,
+    size_t amount_min_per_thread,
+    const std::function<void(size_t, size_t)> &process) {
+  size_t amount_threads = std::min(
+      static_cast<size_t>(std::thread::hardware_concurrency()),
+      amount / amount_min_per_thread);
+
+  if (amount_threads < 2) {
+    process(0, amount);
+
+    return;
+  }
+
+  size_t amount_per_thread = (amount + amount_threads - 1) / amount_threads;
 
-  int ch = getchar();
+  std::vector<std::thread> threads;
 
-  while (10 != ch) {
-    ch = getchar();
+  for (size_t index = 0; index < amount; index += amount_per_thread) {
+    threads.emplace_back(
+        process,
+        index,
+        std::min(index + amount_per_thread, amount));
   }
 
-  // Make echo work, go to COOKED mode
-  system("stty echo");
-  system("stty -cbreak");
+  for (auto &thread : threads) thread.join();
 }
 
 }  // namespace helper
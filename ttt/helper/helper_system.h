@@ -28,13 +28,19 @@
 #define TTT_HELPER_HELPER_SYSTEM_H_
 
 #include <ttt/helper/helper_string.h>
+#include <ttt/helper/helper_tui.h>
+
+#include <spawn.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
 
 #include <cstring>
 #include <clocale>
 #include <cstdlib>
-#include <sys/ioctl.h>
+#include <functional>
 #include <string>
-#include <unistd.h>
+#include <thread>
+#include <vector>
 
 namespace helper::System {
 
@@ -69,14 +75,30 @@ extern std::string GetBinaryPath(char **argv, size_t strLenExecutableName);
 // Get amount of columns in current terminal
 int GetMaxCharsPerTerminalRow();
 
+// Get amount of lines in current terminal, 0 if stdout is no terminal
+int GetAmountTerminalRows();
+
 // Get language key from system default locale
 extern std::string GetLanguageKey();
 
+// Launch given command w/ arguments (w/o shell, w/o waiting for it)
+extern bool Spawn(const std::vector<std::string> &arguments);
+
+// Wait for any of the given keys being pressed, return pressed key
+int WaitForKeyPress(const char *keys);
+
 bool GetYesOrNoKeyPress();
 bool GetNoOrYesKeyPress();
 
 void WaitForEnterKeyPress();
 
+// Invoke given function on consecutive sub-ranges of [0, amount),
+// on up to one thread per core, w/ at least given amount of items each
+extern void ForEachInRange(
+    size_t amount,
+    size_t amount_min_per_thread,
+    const std::function<void(size_t, size_t)> &process);
+
 }  // namespace helper::System
 
 #endif  // TTT_HELPER_HELPER_SYSTEM_H_
@@ -28,8 +28,119 @@
 
 namespace helper {
 
+namespace {
+struct termios terminal_mode_original{};
+bool is_terminal_mode_changed = false;
+bool is_fullscreen = false;
+
+// Leave alternate screen, re-enable line wrapping, show cursor
+const char kAnsiLeaveFullscreen[] = "\033[?7h\033[?25h\033[?1049l";
+
+// Restore terminal when aborted via CTRL+c while in cbreak mode
+void RestoreTerminalModeOnSignal(int signal_number) {
+  tcsetattr(STDIN_FILENO, TCSANOW, &terminal_mode_original);
+
+  if (is_fullscreen) {
+    write(STDOUT_FILENO, kAnsiLeaveFullscreen, sizeof kAnsiLeaveFullscreen - 1);
+  }
+
+  std::signal(signal_number, SIG_DFL);
+  std::raise(signal_number);
+}
+}  // namespace
+
+// Clear screen and scrollback, move cursor home
 void Tui::ClearConsole() {
-  system("clear");
+  std::cout << "\033[H\033[2J\033[3J" << std::flush;
+}
+
+// Switch terminal to non-canonical mode w/o echo
+bool Tui::EnterCbreakMode() {
+  if (is_terminal_mode_changed) return true;
+
+  if (!isatty(STDIN_FILENO)
+      || tcgetattr(STDIN_FILENO, &terminal_mode_original) == -1) {
+    return false;
+  }
+
+  struct termios terminal_mode_cbreak = terminal_mode_original;
+  terminal_mode_cbreak.c_lflag &= ~(static_cast<tcflag_t>(ICANON | ECHO));
+  terminal_mode_cbreak.c_cc[VMIN] = 1;
+  terminal_mode_cbreak.c_cc[VTIME] = 0;
+
+  if (tcsetattr(STDIN_FILENO, TCSANOW, &terminal_mode_cbreak) == -1) {
+    return false;
+  }
+
+  is_terminal_mode_changed = true;
+
+  std::signal(SIGINT, RestoreTerminalModeOnSignal);
+  std::signal(SIGTERM, RestoreTerminalModeOnSignal);
+
+  return true;
+}
+
+// Restore terminal mode saved by EnterCbreakMode()
+void Tui::RestoreTerminalMode() {
+  if (!is_terminal_mode_changed) return;
+
+  tcsetattr(STDIN_FILENO, TCSANOW, &terminal_mode_original);
+  is_terminal_mode_changed = false;
+
+  std::signal(SIGINT, SIG_DFL);
+  std::signal(SIGTERM, SIG_DFL);
+}
+
+// Read single key (byte) from stdin, unbuffered
+int Tui::ReadKey() {
+  unsigned char ch;
+
+  return read(STDIN_FILENO, &ch, 1) == 1 ? ch : -1;
+}
+
+// Switch to alternate screen w/o line wrapping and cursor
+void Tui::EnterFullscreen() {
+  std::cout << "\033[?1049h\033[?25l\033[?7l" << std::flush;
+  is_fullscreen = true;
+}
+
+// Return to the normal screen, as it was before EnterFullscreen()
+void Tui::LeaveFullscreen() {
+  if (!is_fullscreen) return;
+
+  std::cout << kAnsiLeaveFullscreen << std::flush;
+  is_fullscreen = false;
+}
+
+bool Tui::IsStdoutTerminal() {
+  return 1 == isatty(STDOUT_FILENO);
+}
+
+// Write given buffer to stdout, continuing after partial writes
+bool Tui::WriteToStdout(std::string *buffer) {
+  std::cout.flush();
+
+  const char *data = buffer->data();
+  size_t length = buffer->size();
+
+  while (length > 0) {
+    ssize_t written = write(STDOUT_FILENO, data, length);
+
+    if (-1 == written) {
+      if (EINTR == errno) continue;
+
+      buffer->clear();
+
+      return false;
+    }
+
+    data += written;
+    length -= static_cast<size_t>(written);
+  }
+
+  buffer->clear();
+
+  return true;
 }
 
 }  // namespace helper
@@ -27,7 +27,13 @@
 #ifndef TTT_HELPER_HELPER_TUI_H_
 #define TTT_HELPER_HELPER_TUI_H_
 
+#include <termios.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
 #include <cstdlib>
+#include <iostream>
 #include <string>
 
 namespace helper::Tui {
@@ -39,6 +45,28 @@ const std::string kAnsiFormatInverted = "\033[7m";
 
 void ClearConsole();
 
+// Switch terminal (stdin) to non-canonical mode w/o echo, keys are available
+// w/o pressing ENTER. Returns false if stdin is no terminal
+bool EnterCbreakMode();
+
+// Restore terminal mode saved by EnterCbreakMode()
+void RestoreTerminalMode();
+
+// Read single key (byte) from stdin. Returns -1 on EOF / error
+int ReadKey();
+
+// Switch to alternate screen w/o line wrapping and cursor, e.g. for a pager.
+// Left also when aborted via CTRL+c in cbreak mode
+void EnterFullscreen();
+void LeaveFullscreen();
+
+// Is stdout a terminal? (not e.g. piped into a file or another program)
+bool IsStdoutTerminal();
+
+// Write given buffer to stdout via as few syscalls as possible, bypassing
+// iostreams (flushed before). Clears the buffer, keeping its capacity
+bool WriteToStdout(std::string *buffer);
+
 }  // namespace helper::Tui
 
 #endif  // TTT_HELPER_HELPER_TUI_H_
@@ -0,0 +1,183 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/lib/libttt.h>
+#include <ttt/lib/timesheet.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+struct ttt_timesheet {
+  tictac_track::Timesheet timesheet;
+};
+
+namespace {
+
+// Run given command, arguments resolved as by the ttt executable
+int Execute(
+    ttt_timesheet *timesheet,
+    const std::vector<std::string> &arguments) {
+  if (nullptr == timesheet) return TTT_ERROR;
+
+  return timesheet->timesheet.Execute(arguments) ? TTT_OK : TTT_ERROR;
+}
+
+// Get arguments of given command, of the entry w/ given ID (commands
+// default to the latest entry)
+std::vector<std::string> GetArgumentsOfEntry(const char *command, int id) {
+  std::vector<std::string> arguments{command};
+
+  if (TTT_ID_LATEST != id) arguments.push_back("i=" + std::to_string(id));
+
+  return arguments;
+}
+
+}  // namespace
+
+int ttt_get_api_version(void) {
+  return TTT_API_VERSION;
+}
+
+ttt_timesheet *ttt_open(const char *path_directory) {
+  if (nullptr == path_directory
+      || !tictac_track::Timesheet::Init(path_directory)) {
+    return nullptr;
+  }
+
+  auto *timesheet = new (std::nothrow) ttt_timesheet();
+
+  if (nullptr != timesheet && !timesheet->timesheet.Refresh()) {
+    delete timesheet;
+
+    return nullptr;
+  }
+
+  return timesheet;
+}
+
+void ttt_close(ttt_timesheet *timesheet) {
+  delete timesheet;
+}
+
+int ttt_get_amount_entries(ttt_timesheet *timesheet) {
+  if (nullptr == timesheet || !timesheet->timesheet.Refresh()) {
+    return TTT_ERROR;
+  }
+
+  return static_cast<int>(timesheet->timesheet.GetEntries().size());
+}
+
+int ttt_get_entry(ttt_timesheet *timesheet, int id, ttt_entry *entry) {
+  if (nullptr == timesheet
+      || nullptr == entry
+      || !timesheet->timesheet.Refresh()) {
+    return TTT_ERROR;
+  }
+
+  const auto &entries = timesheet->timesheet.GetEntries();
+
+  if (TTT_ID_LATEST == id) id = static_cast<int>(entries.size()) - 1;
+
+  if (id < 0 || id >= static_cast<int>(entries.size())) return TTT_ERROR;
+
+  const tictac_track::Timesheet::Entry &entry_parsed = entries[id];
+
+  entry->id = id;
+  entry->date = static_cast<int>(
+      tictac_track::ReportMeta::GetDate(entry_parsed.timestamp));
+  entry->week = tictac_track::ReportMeta::GetWeek(entry_parsed.timestamp);
+  entry->is_ongoing =
+      tictac_track::ReportMeta::IsOngoing(entry_parsed.timestamp) ? 1 : 0;
+  entry->day = entry_parsed.day.c_str();
+  entry->start = entry_parsed.start.c_str();
+  entry->end = entry_parsed.end.c_str();
+  entry->task = entry_parsed.task.c_str();
+  entry->comment = entry_parsed.comment.c_str();
+  entry->duration = entry_parsed.duration.c_str();
+  entry->sum_task_day = entry_parsed.sum_task_day.c_str();
+  entry->sum_day = entry_parsed.sum_day.c_str();
+  entry->balance = entry_parsed.balance.c_str();
+
+  return TTT_OK;
+}
+
+int ttt_start(ttt_timesheet *timesheet, int task, const char *comment) {
+  std::vector<std::string> arguments{"s"};
+
+  if (nullptr != comment) arguments.push_back(std::string("c=") + comment);
+  if (TTT_NO_TASK != task) arguments.push_back("t=" + std::to_string(task));
+
+  return Execute(timesheet, arguments);
+}
+
+int ttt_stop(ttt_timesheet *timesheet, const char *comment) {
+  std::vector<std::string> arguments{"p"};
+
+  if (nullptr != comment) arguments.push_back(std::string("c=") + comment);
+
+  return Execute(timesheet, arguments);
+}
+
+int ttt_append_comment(
+    ttt_timesheet *timesheet,
+    int id,
+    const char *comment) {
+  if (nullptr == comment) return TTT_ERROR;
+
+  std::vector<std::string> arguments = GetArgumentsOfEntry("c", id);
+  arguments.push_back(std::string("c=") + comment);
+
+  return Execute(timesheet, arguments);
+}
+
+int ttt_set_task(ttt_timesheet *timesheet, int id, int task) {
+  std::vector<std::string> arguments = GetArgumentsOfEntry("t", id);
+  arguments.push_back(std::to_string(task));
+
+  return Execute(timesheet, arguments);
+}
+
+int ttt_remove_entry(ttt_timesheet *timesheet, int id) {
+  return Execute(timesheet, GetArgumentsOfEntry("rm", id));
+}
+
+int ttt_undo(ttt_timesheet *timesheet) {
+  return Execute(timesheet, {"z"});
+}
+
+int ttt_execute(
+    ttt_timesheet *timesheet,
+    int argc,
+    const char *const *argv) {
+  if (argc < 1 || nullptr == argv) return TTT_ERROR;
+
+  return Execute(timesheet, std::vector<std::string>(argv, argv + argc));
+}
+
+const char *ttt_get_output(const ttt_timesheet *timesheet) {
+  return nullptr == timesheet ? "" : timesheet->timesheet.GetOutput().c_str();
+}
@@ -0,0 +1,128 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+  libttt: C API of tictac-track, for embedding into host applications
+
+  A handle keeps the parsed timesheet in memory across calls, it is parsed
+  again only after the timesheet file has changed. Modifications run the
+  same commands as the ttt executable (w/ locking, undo history, status
+  and rollups), their messages are captured instead of printed.
+
+  Strings returned by the API remain valid until the next call w/ the same
+  handle. Configuration (.ttt.ini) is process-wide: all handles of a
+  process must use the same directory.
+*/
+
+#ifndef TTT_LIB_LIBTTT_H_
+#define TTT_LIB_LIBTTT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TTT_API_VERSION 1
+
+#define TTT_OK 0
+#define TTT_ERROR (-1)
+
+// ID referring to the latest entry
+#define TTT_ID_LATEST (-1)
+
+// Task number of entries w/o task, when given as task
+#define TTT_NO_TASK (-1)
+
+typedef struct ttt_timesheet ttt_timesheet;
+
+// Entry of the timesheet. Dates are yyyymmdd, times "hh:mm" (or "" if not
+// set), comments are HTML-decoded
+typedef struct ttt_entry {
+  int id;
+  int date;
+  int week;
+  int is_ongoing;
+  const char *day;
+  const char *start;
+  const char *end;
+  const char *task;
+  const char *comment;
+  const char *duration;
+  const char *sum_task_day;
+  const char *sum_day;
+  const char *balance;
+} ttt_entry;
+
+int ttt_get_api_version(void);
+
+// Open timesheet configured in .ttt.ini within given (existing) directory,
+// config and timesheet are created if missing. Returns NULL on failure
+ttt_timesheet *ttt_open(const char *path_directory);
+
+void ttt_close(ttt_timesheet *timesheet);
+
+int ttt_get_amount_entries(ttt_timesheet *timesheet);
+
+// Get entry of given ID (TTT_ID_LATEST: latest entry)
+int ttt_get_entry(ttt_timesheet *timesheet, int id, ttt_entry *entry);
+
+// Start entry, of given task if not TTT_NO_TASK, commented if not NULL
+int ttt_start(ttt_timesheet *timesheet, int task, const char *comment);
+
+// Stop ongoing entry, append given comment if not NULL
+int ttt_stop(ttt_timesheet *timesheet, const char *comment);
+
+// Append given text to comment of entry of given ID (or TTT_ID_LATEST,
+// as also for setting the task and removing)
+int ttt_append_comment(
+    ttt_timesheet *timesheet,
+    int id,
+    const char *comment);
+
+// Set task of entry of given ID
+int ttt_set_task(ttt_timesheet *timesheet, int id, int task);
+
+int ttt_remove_entry(ttt_timesheet *timesheet, int id);
+
+// Undo latest modification
+int ttt_undo(ttt_timesheet *timesheet);
+
+// Run command given like arguments of the ttt executable, w/o its name.
+// E.g. {"v", "d", "--json"} outputs entries of the current day as JSON.
+// Interactive commands (pager, watch, clear w/o "y") are not supported,
+// views other than JSON are written to stdout
+int ttt_execute(
+    ttt_timesheet *timesheet,
+    int argc,
+    const char *const *argv);
+
+// Get output (messages, JSON) of the latest modification or command
+const char *ttt_get_output(const ttt_timesheet *timesheet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TTT_LIB_LIBTTT_H_
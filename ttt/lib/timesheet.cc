@@ -0,0 +1,160 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <ttt/lib/timesheet.h>
+
+namespace tictac_track {
+
+std::string Timesheet::path_directory_;
+std::string Timesheet::path_executable_;
+char *Timesheet::argv_config_[2] = {nullptr, nullptr};
+
+// Init config in given directory, ensure the timesheet exists
+bool Timesheet::Init(const std::string &path_directory) {
+  char path_real[PATH_MAX];
+
+  if (nullptr == realpath(path_directory.c_str(), path_real)) return false;
+
+  std::string path = std::string(path_real).append("/");
+
+  if (!path_directory_.empty()) return path == path_directory_;
+
+  path_directory_ = path;
+  path_executable_ = path + "ttt";
+  argv_config_[0] = &path_executable_[0];
+
+  AppConfig::GetInstance(argv_config_);
+
+  return ReportCrud::GetInstance().ReportExists();
+}
+
+// Parse timesheet again, if it changed since it was parsed last
+bool Timesheet::Refresh() {
+  std::string path = AppConfig::GetInstance().GetReportFilePath();
+
+  uint64_t size_file;
+  int64_t time_modified;
+
+  if (!helper::File::GetSizeAndTimeModified(
+      path, &size_file, &time_modified)) {
+    return false;
+  }
+
+  if (size_file == size_file_ && time_modified == time_modified_) return true;
+
+  std::string html;
+
+  if (!helper::File::ReadFile(path, &html) || !Parse(html)) return false;
+
+  size_file_ = size_file;
+  time_modified_ = time_modified;
+
+  return true;
+}
+
+const std::vector<Timesheet::Entry> &Timesheet::GetEntries() const {
+  return entries_;
+}
+
+// Run command of given arguments, capturing its output
+bool Timesheet::Execute(const std::vector<std::string> &arguments) {
+  std::vector<std::string> argv_strings{path_executable_};
+  argv_strings.insert(argv_strings.end(), arguments.begin(), arguments.end());
+
+  std::vector<char *> argv;
+
+  for (std::string &argument : argv_strings) argv.push_back(&argument[0]);
+
+  argv.push_back(nullptr);
+
+  std::ostringstream output;
+  std::streambuf *buffer_stdout = std::cout.rdbuf(output.rdbuf());
+
+  bool result = false;
+
+  try {
+    if (argv_strings.size() > 1) {
+      App app(static_cast<int>(argv_strings.size()), argv.data());
+
+      result = app.Process();
+    }
+  } catch (...) {
+    result = false;
+  }
+
+  ReportLock::Release();
+
+  std::cout.rdbuf(buffer_stdout);
+
+  output_ = output.str();
+
+  // Parse again at next access, also if modified w/in the same time tick
+  time_modified_ = -1;
+
+  return result;
+}
+
+const std::string &Timesheet::GetOutput() const {
+  return output_;
+}
+
+bool Timesheet::Parse(const std::string &html) {
+  std::string_view rows;
+
+  if (!ReportParser::GetTableRows(html, &rows)) return false;
+
+  entries_.clear();
+
+  std::string_view cells[Report::Index_Balance + 1];
+  std::string_view row;
+
+  for (size_t offset = 0; ReportParser::GetNextRow(rows, &offset, &row);) {
+    if (ReportParser::GetCellsOfRow(row, cells, Report::Index_Balance + 1)
+        <= Report::Index_Duration) {
+      continue;
+    }
+
+    Entry &entry = entries_.emplace_back();
+
+    entry.timestamp = ReportMeta::Encode(cells[Report::Index_Meta]);
+    entry.day = cells[Report::Index_Day];
+    entry.start = cells[Report::Index_Start];
+    entry.end = cells[Report::Index_End];
+    entry.task = cells[Report::Index_Issue];
+
+    helper::Html::Decode(
+        std::string(cells[Report::Index_Comment]), &entry.comment);
+
+    entry.duration = cells[Report::Index_Duration];
+    entry.sum_task_day = cells[Report::Index_SumTaskDay];
+    entry.sum_day = cells[Report::Index_SumDay];
+    entry.balance = cells[Report::Index_Balance];
+  }
+
+  return true;
+}
+
+}  // namespace tictac_track
@@ -0,0 +1,108 @@
+/*
+  Copyright (c) Kay Stenschke
+  All rights reserved.
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+   * Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of  nor the names of its contributors may be used to
+     endorse or promote products derived from this software without specific
+     prior written permission.
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TTT_LIB_TIMESHEET_H_
+#define TTT_LIB_TIMESHEET_H_
+
+#include <climits>
+#include <cstdlib>
+
+#include <ttt/class/app/app.h>
+#include <ttt/class/app/app_config.h>
+#include <ttt/class/report/report.h>
+#include <ttt/class/report/report_crud.h>
+#include <ttt/class/report/report_lock.h>
+#include <ttt/class/report/report_meta.h>
+#include <ttt/class/report/report_parser.h>
+
+#include <ttt/helper/helper_file.h>
+#include <ttt/helper/helper_html.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tictac_track {
+
+// Timesheet embedded into a host application: entries are kept parsed in
+// memory and parsed again only after the timesheet file changed.
+// Commands run as in the ttt executable, w/ their output captured
+class Timesheet {
+ public:
+  struct Entry {
+    uint64_t timestamp = 0;
+    std::string day;
+    std::string start;
+    std::string end;
+    std::string task;
+    // HTML-decoded
+    std::string comment;
+    std::string duration;
+    std::string sum_task_day;
+    std::string sum_day;
+    std::string balance;
+  };
+
+  // Init config in given directory, ensure the timesheet exists.
+  // Config is process-wide: fails for any other directory than the 1st
+  static bool Init(const std::string &path_directory);
+
+  // Parse timesheet again, if it changed since it was parsed last
+  bool Refresh();
+
+  [[nodiscard]] const std::vector<Entry> &GetEntries() const;
+
+  // Run command of given arguments (w/o name of the executable),
+  // capturing its output
+  bool Execute(const std::vector<std::string> &arguments);
+
+  [[nodiscard]] const std::string &GetOutput() const;
+
+ private:
+  // Directory of the config, and path of an executable within it
+  // (as argv[0] resolving the config), kept for the lifetime of the process
+  static std::string path_directory_;
+  static std::string path_executable_;
+  static char *argv_config_[2];
+
+  std::vector<Entry> entries_;
+
+  // Size and modification time of the timesheet file when parsed
+  uint64_t size_file_ = 0;
+  int64_t time_modified_ = -1;
+
+  std::string output_;
+
+  bool Parse(const std::string &html);
+};
+
+}  // namespace tictac_track
+
+#endif  // TTT_LIB_TIMESHEET_H_
@@ -26,6 +26,7 @@
 
 #include <ttt/class/app/app_config.h>
 #include <ttt/class/report/report_crud.h>
+#include <ttt/class/report/report_lock.h>
 #include <ttt/class/app/app.h>
 
 /**
@@ -34,7 +35,7 @@
   */
 int main(int argc, char **argv) {
   // Ensure config and timesheet HTML files exist
-  auto config = tictac_track::AppConfig::GetInstance(argv);
+  tictac_track::AppConfig::GetInstance(argv);
 
   auto report_crud = tictac_track::ReportCrud::GetInstance();
 
@@ -47,6 +48,8 @@ int main(int argc, char **argv) {
 
   if (argc > 1) {
     app->Process();
+
+    tictac_track::ReportLock::Release();
   }
 
   return 0;